@@ -0,0 +1,1138 @@
+/*
+    File: BasicRedBlackTree.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: BasicRedBlackTree, RedBlackMap, RedBlackSet, NodeLayout, NoTreeEvents
+    Description: Header-only red-black tree with a pluggable comparator, allocator, node layout
+                 and event hooks; the course catalog's RedBlackTree is one instantiation
+*/
+#ifndef BASIC_RED_BLACK_TREE_H
+#define BASIC_RED_BLACK_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodeArena.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+// Enumeration for node colors in the Red-Black Tree.
+enum Color { RED, BLACK };
+
+/*
+* Structure: NodeLayout
+* Description: Compile-time choice of what a node carries besides its children and color.
+*              ParentLinks: a parent pointer, so iterators step in amortized O(1) and stay valid
+*              until their own element is erased. Without it nodes are a pointer smaller, but
+*              iterators carry their path from the root and any insert or erase invalidates them.
+*              SubtreeSizes: the number of nodes below each node (32 bits, in the padding after
+*              the color), which rank and select need.
+*/
+template <bool ParentLinks, bool SubtreeSizes = false>
+struct NodeLayout {
+    static constexpr bool parentLinks = ParentLinks;
+    static constexpr bool subtreeSizes = SubtreeSizes;
+};
+
+using LinkedNodes = NodeLayout<true>;
+using CompactNodes = NodeLayout<false>;
+
+/*
+* Structure: NoTreeEvents
+* Description: The default event hooks. The tree calls them as it searches and rebalances and
+*              they compile to nothing; a type with the same members can count them instead.
+*/
+struct NoTreeEvents {
+    void searchStep() const {}
+    void leftRotation() const {}
+    void rightRotation() const {}
+    void recolored(unsigned) const {}
+    void insertFixupStep() const {}
+    void eraseFixupStep() const {}
+};
+
+// Key extraction for sets (the value is the key) and maps (the key is the pair's first).
+struct IdentityKey {
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+};
+
+struct PairFirstKey {
+    template <typename Pair>
+    const typename Pair::first_type& operator()(const Pair& pair) const { return pair.first; }
+};
+
+// True when Compare declares is_transparent, so lookups may pass other key types.
+template <typename Compare, typename = void>
+struct IsTransparentCompare : std::false_type {};
+
+template <typename Compare>
+struct IsTransparentCompare<Compare, std::void_t<typename Compare::is_transparent>> : std::true_type {};
+
+// Link fields for each layout, in the order a descent reads them.
+template <typename Node, bool ParentLinks, bool SubtreeSizes>
+struct RBLinks;
+
+template <typename Node>
+struct RBLinks<Node, true, true> {
+    Node* left = nullptr;
+    Node* right = nullptr;
+    Node* parent = nullptr;
+    Color color = RED;
+    std::uint32_t size = 1;     // nodes in the subtree rooted here, this one included
+};
+
+template <typename Node>
+struct RBLinks<Node, true, false> {
+    Node* left = nullptr;
+    Node* right = nullptr;
+    Node* parent = nullptr;
+    Color color = RED;
+};
+
+template <typename Node>
+struct RBLinks<Node, false, true> {
+    Node* left = nullptr;
+    Node* right = nullptr;
+    Color color = RED;
+    std::uint32_t size = 1;
+};
+
+template <typename Node>
+struct RBLinks<Node, false, false> {
+    Node* left = nullptr;
+    Node* right = nullptr;
+    Color color = RED;
+};
+
+/*
+* Structure: RBNode
+* Description: A tree node: the layout's links, then the value. New nodes are red and unlinked.
+*/
+template <typename Value, typename Layout>
+struct RBNode : RBLinks<RBNode<Value, Layout>, Layout::parentLinks, Layout::subtreeSizes> {
+    Value value;
+
+    template <typename... Args>
+    explicit RBNode(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+/*
+* Class: BasicRedBlackTree
+* Description: An ordered container of Values, each with a Key taken from it by KeyOfValue and
+*              ordered by Compare. Equal keys are allowed: insert places a value after those
+*              with the same key, and lookups find the first of them.
+*
+*              Compare may be transparent (declare is_transparent): every lookup then takes any
+*              type Compare accepts, such as a string_view or const char* for string keys, and
+*              compares it as is. With an ordinary Compare the argument is converted to Key
+*              once per call.
+*
+*              Nodes are allocated from a NodeArena whose blocks come from Allocator, so the
+*              tree makes one allocation per 4096 nodes and clear() frees them all at once.
+*              Layout picks parent links and subtree sizes (NodeLayout); Events receives a call
+*              per search step, rotation, recoloring and fixup iteration (NoTreeEvents).
+*
+*              Insertion and erasure record the path from the root as they descend and rebalance
+*              along it, so both layouts share one implementation; parent links are only kept
+*              up to date when the layout has them.
+*/
+template <typename Key, typename Value, typename KeyOfValue, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Value>, typename Layout = LinkedNodes,
+          typename Events = NoTreeEvents>
+class BasicRedBlackTree {
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using Node = RBNode<Value, Layout>;
+
+private:
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+    // A red-black tree is at most 2 log2(n + 1) high, so this bounds every path.
+    static constexpr std::size_t maxDepth = 2 * 8 * sizeof(std::size_t);
+
+    /*
+    * Structure: Path
+    * Description: The nodes from the root down to the current one. Copies only the used part.
+    */
+    struct Path {
+        Node* nodes[maxDepth];
+        std::size_t depth;
+
+        Path() : depth(0) {}
+        Path(const Path& other) : depth(other.depth) {
+            std::copy(other.nodes, other.nodes + depth, nodes);
+        }
+        Path& operator=(const Path& other) {
+            depth = other.depth;
+            std::copy(other.nodes, other.nodes + depth, nodes);
+            return *this;
+        }
+
+        void push(Node* node) { nodes[depth++] = node; }
+        Node* pop() { return nodes[--depth]; }
+        Node* back() const { return nodes[depth - 1]; }
+    };
+
+    static constexpr bool isTransparent = IsTransparentCompare<Compare>::value;
+
+public:
+    /*
+    * Class: Iterator
+    * Description: Bidirectional iterator in key order. With parent links it is a node pointer;
+    *              without, it holds the path to its node. Decrementing end() yields the last
+    *              element.
+    */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Value*, Value*>;
+        using reference = std::conditional_t<Const, const Value&, Value&>;
+
+        Iterator() = default;
+
+        // An iterator converts to a const_iterator.
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        Iterator(const Iterator<WasConst>& other) : tree(other.tree), state(other.state) {}
+
+        reference operator*() const { return node()->value; }
+        pointer operator->() const { return &node()->value; }
+
+        Iterator& operator++() {
+            if constexpr (Layout::parentLinks)
+                state = successor(state);
+            else
+                stepForward(state);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        Iterator& operator--() {
+            if constexpr (Layout::parentLinks)
+                state = state ? predecessor(state) : maximum(tree->root);
+            else
+                stepBackward(tree->root, state);
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return node() == other.node(); }
+        bool operator!=(const Iterator& other) const { return node() != other.node(); }
+
+    private:
+        using State = std::conditional_t<Layout::parentLinks, Node*, Path>;
+
+        const BasicRedBlackTree* tree = nullptr;    // needed to step back from end()
+        State state{};                              // null or empty for end()
+
+        Iterator(const BasicRedBlackTree* tree, const State& state) : tree(tree), state(state) {}
+
+        Node* node() const {
+            if constexpr (Layout::parentLinks)
+                return state;
+            else
+                return state.depth ? state.back() : nullptr;
+        }
+
+        friend class BasicRedBlackTree;
+        template <bool> friend class Iterator;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit BasicRedBlackTree(const Compare& compare = Compare(), const Allocator& allocator = Allocator())
+        : nodes(4096, NodeAllocator(allocator)), comp(compare) {
+    }
+
+    // Nodes are linked by raw pointers into the arena, so the tree moves but never copies.
+    BasicRedBlackTree(const BasicRedBlackTree&) = delete;
+    BasicRedBlackTree& operator=(const BasicRedBlackTree&) = delete;
+
+    BasicRedBlackTree(BasicRedBlackTree&& other) noexcept
+        : nodes(std::move(other.nodes)), root(other.root), comp(std::move(other.comp)),
+          keyOf(std::move(other.keyOf)), hooks(std::move(other.hooks)) {
+        other.root = nullptr;
+    }
+
+    BasicRedBlackTree& operator=(BasicRedBlackTree&& other) noexcept {
+        if (this != &other) {
+            nodes = std::move(other.nodes);
+            root = other.root;
+            comp = std::move(other.comp);
+            keyOf = std::move(other.keyOf);
+            hooks = std::move(other.hooks);
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return nodes.size(); }
+    bool empty() const { return root == nullptr; }
+    Allocator get_allocator() const { return Allocator(nodes.get_allocator()); }
+
+    // The event hooks, e.g. to point counting hooks at their counters.
+    Events& events() { return hooks; }
+
+    // Read-only access to the nodes, for code that walks the shape (checks, statistics).
+    const Node* rootNode() const { return root; }
+
+    // Inserts a value constructed in its node from args, after any with an equal key.
+    template <typename... Args>
+    Value& emplace(Args&&... args) {
+        Node* node = nodes.create(std::forward<Args>(args)...);
+        Path path;
+        bool goLeft = descendForInsert(keyOf(node->value), path);
+        attach(node, path, goLeft);
+        return node->value;
+    }
+
+    Value& insert(const Value& value) { return emplace(value); }
+    Value& insert(Value&& value) { return emplace(std::move(value)); }
+
+    // Inserts a value constructed from args unless one with an equal key is stored. Returns
+    // the stored value and whether it was inserted.
+    template <typename... Args>
+    std::pair<Value*, bool> emplaceUnique(Args&&... args) {
+        Node* node = nodes.create(std::forward<Args>(args)...);
+        Path path;
+        Node* lastRight = nullptr;      // greatest node not after the new key
+        bool goLeft = descendForInsert(keyOf(node->value), path, &lastRight);
+        if (lastRight && !comp(keyOf(lastRight->value), keyOf(node->value))) {
+            nodes.destroy(node);
+            return { &lastRight->value, false };
+        }
+        attach(node, path, goLeft);
+        return { &node->value, true };
+    }
+
+    std::pair<Value*, bool> insertUnique(const Value& value) { return emplaceUnique(value); }
+    std::pair<Value*, bool> insertUnique(Value&& value) { return emplaceUnique(std::move(value)); }
+
+    // Removes the element at pos, which must be dereferenceable.
+    void erase(iterator pos) { erase(const_iterator(pos)); }
+
+    void erase(const_iterator pos) {
+        Path path;
+        if constexpr (Layout::parentLinks) {
+            std::size_t depth = 0;
+            for (Node* node = pos.state; node; node = node->parent)
+                ++depth;
+            path.depth = depth;
+            for (Node* node = pos.state; node; node = node->parent)
+                path.nodes[--depth] = node;
+        }
+        else {
+            path = pos.state;
+        }
+        eraseAt(path);
+    }
+
+    // Removes the first element with this key. Returns false if there is none.
+    template <typename K>
+    bool erase(const K& key) {
+        const auto& k = probe(key);
+        Path path;
+        Node* node = boundNode<false, true>(k, path);
+        if (!node || comp(k, keyOf(node->value)))
+            return false;
+        eraseAt(path);
+        return true;
+    }
+
+    // The first value with this key, or null. Cheaper than find for the parent-less layout,
+    // which would build an iterator's path.
+    template <typename K>
+    const Value* findValue(const K& key) const {
+        const auto& k = probe(key);
+        Path unused;
+        Node* node = boundNode<false, false>(k, unused);
+        return node && !comp(k, keyOf(node->value)) ? &node->value : nullptr;
+    }
+
+    template <typename K>
+    Value* findValue(const K& key) {
+        return const_cast<Value*>(static_cast<const BasicRedBlackTree&>(*this).findValue(key));
+    }
+
+    template <typename K>
+    bool contains(const K& key) const { return findValue(key) != nullptr; }
+
+    template <typename K>
+    const_iterator find(const K& key) const {
+        const auto& k = probe(key);
+        const_iterator it = bound<false>(k);
+        return it.node() && !comp(k, keyOf(it.node()->value)) ? it : end();
+    }
+
+    template <typename K>
+    iterator find(const K& key) { return unconst(static_cast<const BasicRedBlackTree&>(*this).find(key)); }
+
+    // First element whose key is not less than (upper_bound: greater than) key.
+    template <typename K>
+    const_iterator lower_bound(const K& key) const { return bound<false>(probe(key)); }
+
+    template <typename K>
+    const_iterator upper_bound(const K& key) const { return bound<true>(probe(key)); }
+
+    template <typename K>
+    iterator lower_bound(const K& key) { return unconst(bound<false>(probe(key))); }
+
+    template <typename K>
+    iterator upper_bound(const K& key) { return unconst(bound<true>(probe(key))); }
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        const auto& k = probe(key);
+        return { bound<false>(k), bound<true>(k) };
+    }
+
+    /*
+    * findBatch: Looks up count keys at once; keyAt(i) gives key i (its type must be default
+    *            constructible) and found(i, const Value*) receives the first match or null.
+    *            Up to eight descents run in lockstep, each prefetching the node it reads next,
+    *            so their cache misses overlap.
+    */
+    template <typename KeyAt, typename Found>
+    void findBatch(std::size_t count, KeyAt&& keyAt, Found&& found) const {
+        using K = std::decay_t<decltype(keyAt(std::size_t(0)))>;
+        constexpr std::size_t lanes = 8;
+        K keys[lanes];
+        const Node* next[lanes];
+        const Node* bounds[lanes];
+        for (std::size_t base = 0; base < count; base += lanes) {
+            std::size_t width = count - base < lanes ? count - base : lanes;
+            for (std::size_t i = 0; i < width; ++i) {
+                keys[i] = keyAt(base + i);
+                next[i] = root;
+                bounds[i] = nullptr;
+            }
+            for (bool active = root != nullptr; active;) {
+                active = false;
+                for (std::size_t i = 0; i < width; ++i) {
+                    const Node* node = next[i];
+                    if (!node)
+                        continue;
+                    hooks.searchStep();
+                    if (!comp(keyOf(node->value), keys[i])) {
+                        bounds[i] = node;
+                        node = node->left;
+                    }
+                    else {
+                        node = node->right;
+                    }
+                    next[i] = node;
+                    if (node) {
+                        prefetch(node);
+                        active = true;
+                    }
+                }
+            }
+            for (std::size_t i = 0; i < width; ++i) {
+                const Node* node = bounds[i];
+                found(base + i, node && !comp(keys[i], keyOf(node->value)) ? &node->value : nullptr);
+            }
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, leftmost()); }
+    const_iterator end() const { return const_iterator(this, typename const_iterator::State{}); }
+    iterator begin() { return iterator(this, leftmost()); }
+    iterator end() { return iterator(this, typename iterator::State{}); }
+
+    // Calls visit(const Value&) for every value in key order.
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const Value& value : *this)
+            visit(value);
+    }
+
+    // Number of elements whose key is less than key. O(log n); needs SubtreeSizes.
+    template <typename K>
+    std::size_t rank(const K& key) const {
+        static_assert(Layout::subtreeSizes, "rank needs a NodeLayout with SubtreeSizes");
+        const auto& k = probe(key);
+        std::size_t before = 0;
+        for (const Node* node = root; node;) {
+            if (comp(keyOf(node->value), k)) {
+                before += subtreeSize(node->left) + 1;
+                node = node->right;
+            }
+            else {
+                node = node->left;
+            }
+        }
+        return before;
+    }
+
+    // The element at zero-based position k in key order, or end(). O(log n); needs SubtreeSizes.
+    const_iterator select(std::size_t k) const {
+        static_assert(Layout::subtreeSizes, "select needs a NodeLayout with SubtreeSizes");
+        typename const_iterator::State state{};
+        Node* node = root;
+        while (node) {
+            if constexpr (!Layout::parentLinks)
+                state.push(node);
+            std::size_t leftSize = subtreeSize(node->left);
+            if (k < leftSize) {
+                node = node->left;
+            }
+            else if (k == leftSize) {
+                break;
+            }
+            else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        if constexpr (Layout::parentLinks)
+            state = node;
+        else if (!node)
+            state.depth = 0;
+        return const_iterator(this, state);
+    }
+
+    /*
+    * assignSorted: Replaces the contents with [first, last), which must already be in key order,
+    *               in O(n) and without rotations. The middle element becomes the root of each
+    *               subtree; every level above the last is full, so making the last level red and
+    *               the rest black gives every path the same number of black nodes. Nodes are
+    *               constructed from *it (use move iterators to move the values in).
+    */
+    template <typename RandomIt>
+    void assignSorted(RandomIt first, RandomIt last) {
+        clear();
+        std::size_t count = static_cast<std::size_t>(last - first);
+        nodes.reserve(count);
+        std::size_t fullLevels = 0;
+        while ((std::size_t(2) << fullLevels) - 1 <= count)
+            ++fullLevels;
+        root = buildBalanced(first, 0, count, 0, fullLevels, nullptr);
+        if (root)
+            root->color = BLACK;
+    }
+
+    // Removes every element and frees all nodes in one shot.
+    void clear() {
+        root = nullptr;
+        nodes.clear();
+    }
+
+    // Nodes on the longest root-to-leaf path (0 when empty).
+    std::size_t height() const {
+        std::size_t result = 0;
+        std::vector<std::pair<const Node*, std::size_t>> stack;
+        if (root)
+            stack.push_back({ root, 1 });
+        while (!stack.empty()) {
+            auto [node, depth] = stack.back();
+            stack.pop_back();
+            result = depth > result ? depth : result;
+            if (node->left)
+                stack.push_back({ node->left, depth + 1 });
+            if (node->right)
+                stack.push_back({ node->right, depth + 1 });
+        }
+        return result;
+    }
+
+    // Black nodes on every root-to-leaf path, read off the leftmost one.
+    std::size_t blackHeight() const {
+        std::size_t result = 0;
+        for (const Node* node = root; node; node = node->left)
+            result += node->color == BLACK;
+        return result;
+    }
+
+    // Bytes reserved for nodes, including unused slots in the arena's last block.
+    std::size_t bytesReserved() const { return nodes.bytesReserved(); }
+
+    /*
+    * checkInvariants: Walks every node and describes the first broken rule, or returns null if
+    *                  there is none. The rules: the root is black, no red node has a red child,
+    *                  every path down to a null child passes the same number of black nodes, keys
+    *                  are in order, and the parent links and subtree sizes agree with the shape
+    *                  when the layout keeps them. O(n) with an explicit stack, so a damaged
+    *                  (arbitrarily deep) tree cannot overflow the call stack. For tests and stress runs.
+    */
+    const char* checkInvariants() const {
+        struct Frame {
+            const Node* node;
+            const Node* parent;
+            const Node* low;        // nearest ancestor this node is right of: key must not be less
+            const Node* high;       // nearest ancestor this node is left of: key must not be greater
+            std::size_t blacks;     // black nodes above this one
+        };
+        if (colorOf(root) != BLACK)
+            return "the root is red";
+        std::vector<Frame> stack;
+        if (root)
+            stack.push_back({ root, nullptr, nullptr, nullptr, 0 });
+        std::size_t count = 0;
+        std::size_t pathBlacks = 0;
+        bool sawLeaf = false;
+        while (!stack.empty()) {
+            Frame frame = stack.back();
+            stack.pop_back();
+            const Node* node = frame.node;
+            ++count;
+            if (node->color == RED && colorOf(frame.parent) == RED)
+                return "a red node has a red child";
+            if constexpr (Layout::parentLinks) {
+                if (node->parent != frame.parent)
+                    return "a parent link does not match the shape";
+            }
+            if constexpr (Layout::subtreeSizes) {
+                if (node->size != subtreeSize(node->left) + subtreeSize(node->right) + 1)
+                    return "a subtree size is wrong";
+            }
+            if ((frame.low && comp(keyOf(node->value), keyOf(frame.low->value)))
+                || (frame.high && comp(keyOf(frame.high->value), keyOf(node->value))))
+                return "keys are out of order";
+            std::size_t blacks = frame.blacks + (node->color == BLACK);
+            for (const Node* child : { node->left, node->right }) {
+                if (child)
+                    continue;
+                if (sawLeaf && blacks != pathBlacks)
+                    return "black heights differ between paths";
+                sawLeaf = true;
+                pathBlacks = blacks;
+            }
+            if (node->left)
+                stack.push_back({ node->left, node, frame.low, node, blacks });
+            if (node->right)
+                stack.push_back({ node->right, node, node, frame.high, blacks });
+        }
+        if (count != size())
+            return "the node count does not match size()";
+        return nullptr;
+    }
+
+private:
+    NodeArena<Node, NodeAllocator> nodes;
+    Node* root = nullptr;
+    Compare comp;
+    KeyOfValue keyOf;
+    Events hooks;
+
+    // The lookup argument as the comparator will see it: as is for a transparent Compare,
+    // otherwise converted to Key once.
+    template <typename K>
+    static decltype(auto) probe(const K& key) {
+        if constexpr (isTransparent || std::is_same_v<K, Key>)
+            return (key);
+        else
+            return Key(key);
+    }
+
+    static void prefetch(const void* address) {
+#if defined(_MSC_VER)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(address);
+#endif
+    }
+
+    static std::size_t subtreeSize(const Node* node) {
+        if constexpr (Layout::subtreeSizes)
+            return node ? node->size : 0;
+        else
+            return 0;
+    }
+
+    static Color colorOf(const Node* node) { return node ? node->color : BLACK; }
+
+    template <typename N>
+    static N* minimum(N* node) {
+        while (node->left)
+            node = node->left;
+        return node;
+    }
+
+    template <typename N>
+    static N* maximum(N* node) {
+        while (node->right)
+            node = node->right;
+        return node;
+    }
+
+    // In-order neighbours through parent links (null past either end).
+    static Node* successor(Node* node) {
+        if (node->right)
+            return minimum(node->right);
+        Node* child = node;
+        node = node->parent;
+        while (node && child == node->right) {
+            child = node;
+            node = node->parent;
+        }
+        return node;
+    }
+
+    static Node* predecessor(Node* node) {
+        if (node->left)
+            return maximum(node->left);
+        Node* child = node;
+        node = node->parent;
+        while (node && child == node->left) {
+            child = node;
+            node = node->parent;
+        }
+        return node;
+    }
+
+    // In-order steps along a path (empty past the last element).
+    static void stepForward(Path& path) {
+        Node* node = path.back();
+        if (node->right) {
+            for (node = node->right; node; node = node->left)
+                path.push(node);
+            return;
+        }
+        Node* child = path.pop();
+        while (path.depth && path.back()->right == child)
+            child = path.pop();
+    }
+
+    static void stepBackward(Node* root, Path& path) {
+        if (!path.depth) {
+            for (Node* node = root; node; node = node->right)
+                path.push(node);
+            return;
+        }
+        Node* node = path.back();
+        if (node->left) {
+            for (node = node->left; node; node = node->right)
+                path.push(node);
+            return;
+        }
+        Node* child = path.pop();
+        while (path.depth && path.back()->left == child)
+            child = path.pop();
+    }
+
+    typename const_iterator::State leftmost() const {
+        typename const_iterator::State state{};
+        if constexpr (Layout::parentLinks) {
+            state = root ? minimum(root) : nullptr;
+        }
+        else {
+            for (Node* node = root; node; node = node->left)
+                state.push(node);
+        }
+        return state;
+    }
+
+    iterator unconst(const const_iterator& it) { return iterator(this, it.state); }
+
+    /*
+    * boundNode: One descent that remembers the last node where it went left: the first node
+    *            at or after key (Upper: after). With Record the path is left ending at it.
+    */
+    template <bool Upper, bool Record, typename K>
+    Node* boundNode(const K& key, Path& path) const {
+        Node* node = root;
+        Node* bound = nullptr;
+        std::size_t boundDepth = 0;
+        while (node) {
+            hooks.searchStep();
+            if constexpr (Record)
+                path.push(node);
+            bool left = Upper ? comp(key, keyOf(node->value)) : !comp(keyOf(node->value), key);
+            if (left) {
+                bound = node;
+                if constexpr (Record)
+                    boundDepth = path.depth;
+                node = node->left;
+            }
+            else {
+                node = node->right;
+            }
+        }
+        if constexpr (Record)
+            path.depth = boundDepth;
+        return bound;
+    }
+
+    template <bool Upper, typename K>
+    const_iterator bound(const K& key) const {
+        if constexpr (Layout::parentLinks) {
+            Path unused;
+            return const_iterator(this, boundNode<Upper, false>(key, unused));
+        }
+        else {
+            Path path;
+            boundNode<Upper, true>(key, path);
+            return const_iterator(this, path);
+        }
+    }
+
+    // Records the path to the new key's leaf position; returns whether it goes left of the
+    // last node. lastRight, if given, receives the last node the descent went right at.
+    template <typename K>
+    bool descendForInsert(const K& key, Path& path, Node** lastRight = nullptr) const {
+        bool goLeft = false;
+        for (Node* node = root; node;) {
+            path.push(node);
+            goLeft = comp(key, keyOf(node->value));
+            if (!goLeft && lastRight)
+                *lastRight = node;
+            node = goLeft ? node->left : node->right;
+        }
+        return goLeft;
+    }
+
+    // Links node below the end of path, counts it in the sizes above and rebalances.
+    void attach(Node* node, Path& path, bool goLeft) {
+        Node* parent = path.depth ? path.back() : nullptr;
+        if (!parent)
+            root = node;
+        else if (goLeft)
+            parent->left = node;
+        else
+            parent->right = node;
+        if constexpr (Layout::parentLinks)
+            node->parent = parent;
+        if constexpr (Layout::subtreeSizes) {
+            for (std::size_t i = 0; i < path.depth; ++i)
+                ++path.nodes[i]->size;
+        }
+        path.push(node);
+        insertFixup(path);
+    }
+
+    // Points parent's link to child at replacement instead (the root when parent is null).
+    void replaceChild(Node* parent, Node* child, Node* replacement) {
+        if (!parent)
+            root = replacement;
+        else if (parent->left == child)
+            parent->left = replacement;
+        else
+            parent->right = replacement;
+    }
+
+    void resize(Node* node) {
+        if constexpr (Layout::subtreeSizes)
+            node->size = static_cast<std::uint32_t>(subtreeSize(node->left) + subtreeSize(node->right) + 1);
+    }
+
+    /*
+    * rotateLeft: x's right child y takes x's place under xParent and x becomes y's left child;
+    *             y's old left subtree moves over to x. y takes over x's subtree size.
+    */
+    void rotateLeft(Node* x, Node* xParent) {
+        hooks.leftRotation();
+        Node* y = x->right;
+        x->right = y->left;
+        replaceChild(xParent, x, y);
+        y->left = x;
+        if constexpr (Layout::parentLinks) {
+            if (x->right)
+                x->right->parent = x;
+            y->parent = xParent;
+            x->parent = y;
+        }
+        if constexpr (Layout::subtreeSizes) {
+            y->size = x->size;
+            resize(x);
+        }
+    }
+
+    void rotateRight(Node* x, Node* xParent) {
+        hooks.rightRotation();
+        Node* y = x->left;
+        x->left = y->right;
+        replaceChild(xParent, x, y);
+        y->right = x;
+        if constexpr (Layout::parentLinks) {
+            if (x->left)
+                x->left->parent = x;
+            y->parent = xParent;
+            x->parent = y;
+        }
+        if constexpr (Layout::subtreeSizes) {
+            y->size = x->size;
+            resize(x);
+        }
+    }
+
+    /*
+    * insertFixup: The new node at the end of path is red. While its parent is red too: a red
+    *              uncle is recolored black with the grandparent red, moving the problem two
+    *              levels up; a black uncle is fixed with one or two rotations at the
+    *              grandparent. The root always ends black.
+    */
+    void insertFixup(Path& path) {
+        std::size_t k = path.depth - 1;
+        while (k > 0 && path.nodes[k - 1]->color == RED) {
+            hooks.insertFixupStep();
+            Node* z = path.nodes[k];
+            Node* parent = path.nodes[k - 1];
+            Node* grandparent = path.nodes[k - 2];     // a red parent is never the root
+            Node* above = k >= 3 ? path.nodes[k - 3] : nullptr;
+            if (parent == grandparent->left) {
+                Node* uncle = grandparent->right;
+                if (colorOf(uncle) == RED) {
+                    parent->color = BLACK;
+                    uncle->color = BLACK;
+                    grandparent->color = RED;
+                    hooks.recolored(3);
+                    k -= 2;
+                    continue;
+                }
+                if (z == parent->right) {
+                    rotateLeft(parent, grandparent);
+                    parent = z;
+                }
+                parent->color = BLACK;
+                grandparent->color = RED;
+                hooks.recolored(2);
+                rotateRight(grandparent, above);
+            }
+            else {
+                Node* uncle = grandparent->left;
+                if (colorOf(uncle) == RED) {
+                    parent->color = BLACK;
+                    uncle->color = BLACK;
+                    grandparent->color = RED;
+                    hooks.recolored(3);
+                    k -= 2;
+                    continue;
+                }
+                if (z == parent->left) {
+                    rotateRight(parent, grandparent);
+                    parent = z;
+                }
+                parent->color = BLACK;
+                grandparent->color = RED;
+                hooks.recolored(2);
+                rotateLeft(grandparent, above);
+            }
+            break;
+        }
+        root->color = BLACK;
+    }
+
+    /*
+    * swapWithSuccessor: Exchanges the places (links, color and size) of the node at path[kz]
+    *                    and its in-order successor at path[ky], the leftmost node of its
+    *                    right subtree, and swaps them in the path. Nodes are relinked rather
+    *                    than values copied, so pointers to every value stay valid.
+    */
+    void swapWithSuccessor(Path& path, std::size_t kz, std::size_t ky) {
+        Node* z = path.nodes[kz];
+        Node* y = path.nodes[ky];
+        Node* zParent = kz ? path.nodes[kz - 1] : nullptr;
+        Node* zLeft = z->left;
+        Node* zRight = z->right;
+        Node* yRight = y->right;
+        replaceChild(zParent, z, y);
+        y->left = zLeft;
+        if (ky == kz + 1) {
+            y->right = z;
+        }
+        else {
+            Node* yParent = path.nodes[ky - 1];
+            y->right = zRight;
+            yParent->left = z;
+            if constexpr (Layout::parentLinks) {
+                zRight->parent = y;
+                z->parent = yParent;
+            }
+        }
+        z->left = nullptr;
+        z->right = yRight;
+        if constexpr (Layout::parentLinks) {
+            zLeft->parent = y;
+            y->parent = zParent;
+            if (ky == kz + 1)
+                z->parent = y;
+            if (yRight)
+                yRight->parent = z;
+        }
+        std::swap(z->color, y->color);
+        if constexpr (Layout::subtreeSizes)
+            std::swap(z->size, y->size);
+        path.nodes[kz] = y;
+        path.nodes[ky] = z;
+    }
+
+    /*
+    * eraseAt: Removes the node at the end of path. A node with two children first trades places
+    *          with its successor, so the node unlinked has at most one child, which takes its
+    *          place. Every subtree above loses one node; removing a black node leaves its side
+    *          a black short, which eraseFixup repairs.
+    */
+    void eraseAt(Path& path) {
+        std::size_t k = path.depth - 1;
+        Node* z = path.nodes[k];
+        if (z->left && z->right) {
+            for (Node* node = z->right; node; node = node->left)
+                path.push(node);
+            swapWithSuccessor(path, k, path.depth - 1);
+            k = path.depth - 1;
+        }
+        Node* child = z->left ? z->left : z->right;
+        Node* parent = k ? path.nodes[k - 1] : nullptr;
+        replaceChild(parent, z, child);
+        if constexpr (Layout::parentLinks) {
+            if (child)
+                child->parent = parent;
+        }
+        if constexpr (Layout::subtreeSizes) {
+            for (std::size_t i = 0; i < k; ++i)
+                --path.nodes[i]->size;
+        }
+        if (z->color == BLACK)
+            eraseFixup(path, k, child);
+        nodes.destroy(z);
+    }
+
+    /*
+    * eraseFixup: x (possibly null) sits at path[k] carrying an extra black. The four cases (red
+    *             sibling, black sibling with black children, black sibling with a red near
+    *             child, black sibling with a red far child) are mirrored for each side. Case 1's
+    *             rotation puts the sibling between x's parent and grandparent, so it is spliced
+    *             into the path there.
+    */
+    void eraseFixup(Path& path, std::size_t k, Node* x) {
+        while (k > 0 && colorOf(x) == BLACK) {
+            hooks.eraseFixupStep();
+            Node* parent = path.nodes[k - 1];
+            Node* grandparent = k >= 2 ? path.nodes[k - 2] : nullptr;
+            if (x == parent->left) {
+                Node* w = parent->right;
+                if (colorOf(w) == RED) {
+                    w->color = BLACK;
+                    parent->color = RED;
+                    hooks.recolored(2);
+                    rotateLeft(parent, grandparent);
+                    path.nodes[k - 1] = w;
+                    path.nodes[k] = parent;
+                    grandparent = w;
+                    ++k;
+                    w = parent->right;
+                }
+                if (colorOf(w->left) == BLACK && colorOf(w->right) == BLACK) {
+                    w->color = RED;
+                    hooks.recolored(1);
+                    x = parent;
+                    --k;
+                }
+                else {
+                    if (colorOf(w->right) == BLACK) {
+                        w->left->color = BLACK;
+                        w->color = RED;
+                        hooks.recolored(2);
+                        rotateRight(w, parent);
+                        w = parent->right;
+                    }
+                    w->color = parent->color;
+                    parent->color = BLACK;
+                    hooks.recolored(3);
+                    if (w->right)
+                        w->right->color = BLACK;
+                    rotateLeft(parent, grandparent);
+                    x = root;
+                    k = 0;
+                }
+            }
+            else {
+                Node* w = parent->left;
+                if (colorOf(w) == RED) {
+                    w->color = BLACK;
+                    parent->color = RED;
+                    hooks.recolored(2);
+                    rotateRight(parent, grandparent);
+                    path.nodes[k - 1] = w;
+                    path.nodes[k] = parent;
+                    grandparent = w;
+                    ++k;
+                    w = parent->left;
+                }
+                if (colorOf(w->right) == BLACK && colorOf(w->left) == BLACK) {
+                    w->color = RED;
+                    hooks.recolored(1);
+                    x = parent;
+                    --k;
+                }
+                else {
+                    if (colorOf(w->left) == BLACK) {
+                        w->right->color = BLACK;
+                        w->color = RED;
+                        hooks.recolored(2);
+                        rotateLeft(w, parent);
+                        w = parent->left;
+                    }
+                    w->color = parent->color;
+                    parent->color = BLACK;
+                    hooks.recolored(3);
+                    if (w->left)
+                        w->left->color = BLACK;
+                    rotateRight(parent, grandparent);
+                    x = root;
+                    k = 0;
+                }
+            }
+        }
+        if (x)
+            x->color = BLACK;
+    }
+
+    template <typename RandomIt>
+    Node* buildBalanced(RandomIt first, std::size_t lo, std::size_t hi, std::size_t depth, std::size_t redDepth,
+                        Node* parent) {
+        if (lo >= hi)
+            return nullptr;
+        std::size_t mid = lo + (hi - lo) / 2;
+        Node* node = nodes.create(*(first + static_cast<std::ptrdiff_t>(mid)));
+        node->color = depth == redDepth ? RED : BLACK;
+        if constexpr (Layout::parentLinks)
+            node->parent = parent;
+        if constexpr (Layout::subtreeSizes)
+            node->size = static_cast<std::uint32_t>(hi - lo);
+        node->left = buildBalanced(first, lo, mid, depth + 1, redDepth, node);
+        node->right = buildBalanced(first, mid + 1, hi, depth + 1, redDepth, node);
+        return node;
+    }
+};
+
+/*
+* RedBlackMap / RedBlackSet: The usual shapes. A map holds pair<const Key, T> ordered by the
+* key; with the default transparent std::less<> a map keyed by std::string can be searched
+* with a string_view or string literal without building a string.
+*/
+template <typename Key, typename T, typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>, typename Layout = LinkedNodes>
+using RedBlackMap = BasicRedBlackTree<Key, std::pair<const Key, T>, PairFirstKey, Compare, Allocator, Layout>;
+
+template <typename Key, typename Compare = std::less<>, typename Allocator = std::allocator<Key>,
+          typename Layout = LinkedNodes>
+using RedBlackSet = BasicRedBlackTree<Key, Key, IdentityKey, Compare, Allocator, Layout>;
+
+#endif
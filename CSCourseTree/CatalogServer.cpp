@@ -0,0 +1,366 @@
+/*
+    File: CatalogServer.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: CatalogServer
+    Description: Request parsing, batched answering and the stream/socket transports
+*/
+
+#include "CatalogServer.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Reads whatever is available (at least one byte unless at end of input or on error).
+    long readSome(int fd, char* buffer, std::size_t size) {
+#ifdef _WIN32
+        return _read(fd, buffer, static_cast<unsigned>(size));
+#else
+        for (;;) {
+            ssize_t n = ::read(fd, buffer, size);
+            if (n >= 0 || errno != EINTR)
+                return static_cast<long>(n);
+        }
+#endif
+    }
+
+    // Writes all of data, retrying short writes. Returns false if the peer has gone away.
+    bool writeAll(int fd, std::string_view data) {
+        while (!data.empty()) {
+#ifdef _WIN32
+            int n = _write(fd, data.data(), static_cast<unsigned>(data.size()));
+#else
+            ssize_t n = ::write(fd, data.data(), data.size());
+            if (n < 0 && errno == EINTR)
+                continue;
+#endif
+            if (n <= 0)
+                return false;
+            data.remove_prefix(static_cast<std::size_t>(n));
+        }
+        return true;
+    }
+
+    // A request line split on spaces and tabs. Lines with more words than fit are flagged.
+    struct Words {
+        static constexpr std::size_t capacity = 4;
+        std::string_view word[capacity];
+        std::size_t count = 0;
+        bool tooMany = false;
+    };
+
+    Words splitWords(std::string_view line) {
+        Words words;
+        std::size_t pos = 0;
+        while (pos < line.size()) {
+            while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+                ++pos;
+            std::size_t start = pos;
+            while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t')
+                ++pos;
+            if (pos == start)
+                break;
+            if (words.count == Words::capacity) {
+                words.tooMany = true;
+                break;
+            }
+            words.word[words.count++] = line.substr(start, pos - start);
+        }
+        return words;
+    }
+
+    // Parses an optional limit argument; a missing one means no limit.
+    bool parseLimit(const Words& words, std::size_t index, std::size_t& limit) {
+        limit = static_cast<std::size_t>(-1);
+        if (index >= words.count)
+            return true;
+        std::string_view text = words.word[index];
+        auto result = std::from_chars(text.data(), text.data() + text.size(), limit);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // Appends one course in the catalog's CSV form.
+    void appendRecord(std::string& output, const Course& course) {
+        output += course.courseNumber;
+        output += ',';
+        output += course.courseTitle;
+        for (const auto& prereq : course.prerequisites) {
+            output += ',';
+            output += prereq;
+        }
+        output += '\n';
+    }
+
+    void appendHeader(std::string& output, std::size_t count) {
+        output += "OK ";
+        output += std::to_string(count);
+        output += '\n';
+    }
+
+    void appendError(std::string& output, std::string_view message) {
+        output += "ERR ";
+        output += message;
+        output += '\n';
+    }
+
+    // Answers a request whose records form one iterator range, stopping after limit records.
+    template <typename Iterator>
+    void appendRange(std::string& output, Iterator first, Iterator last, std::size_t limit,
+                     std::vector<const Course*>& scratch) {
+        scratch.clear();
+        for (; first != last && scratch.size() < limit; ++first)
+            scratch.push_back(&*first);
+        appendHeader(output, scratch.size());
+        for (const Course* course : scratch)
+            appendRecord(output, *course);
+    }
+}
+
+CatalogServer::CatalogServer(const RedBlackTree& tree, const PrerequisiteGraph& graph)
+    : tree(tree), graph(graph) {}
+
+/*
+* handle: Two passes over the complete lines. The first splits them and collects the LOOKUP
+*         keys so they can be resolved with one interleaved searchBatch; the second answers
+*         every request in order. Blank lines are skipped without a response.
+*/
+std::size_t CatalogServer::handle(std::string_view input, std::string& output, bool& quit) const {
+    quit = false;
+    std::vector<Words> requests;
+    std::vector<std::string_view> lookupKeys;     // views into input, which outlives them
+    std::size_t used = 0;
+    for (std::size_t end; !quit && (end = input.find('\n', used)) != std::string_view::npos; used = end + 1) {
+        std::string_view line = input.substr(used, end - used);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        Words words = splitWords(line);
+        if (words.count == 0)
+            continue;
+        if (words.word[0] == "QUIT")
+            quit = true;
+        else if (words.word[0] == "LOOKUP" && words.count == 2)
+            lookupKeys.push_back(words.word[1]);
+        requests.push_back(words);
+    }
+
+    std::vector<const Course*> found;
+    tree.searchBatch(lookupKeys, found);
+    std::size_t nextLookup = 0;
+    std::vector<const Course*> scratch;
+    std::size_t limit = 0;
+    for (const Words& words : requests) {
+        std::string_view command = words.word[0];
+        if (words.tooMany) {
+            appendError(output, "too many arguments");
+        }
+        else if (command == "LOOKUP") {
+            if (words.count != 2) {
+                appendError(output, "usage: LOOKUP <number>");
+                continue;
+            }
+            const Course* course = found[nextLookup++];
+            appendHeader(output, course ? 1 : 0);
+            if (course)
+                appendRecord(output, *course);
+        }
+        else if (command == "RANGE") {
+            if ((words.count != 3 && words.count != 4) || !parseLimit(words, 3, limit)) {
+                appendError(output, "usage: RANGE <from> <to> [limit]");
+                continue;
+            }
+            std::string_view from = words.word[1];
+            std::string_view to = words.word[2];
+            if (to <= from)
+                appendHeader(output, 0);
+            else
+                appendRange(output, tree.lower_bound(from), tree.lower_bound(to), limit, scratch);
+        }
+        else if (command == "PREFIX") {
+            if ((words.count != 2 && words.count != 3) || !parseLimit(words, 2, limit)) {
+                appendError(output, "usage: PREFIX <prefix> [limit]");
+                continue;
+            }
+            auto [first, last] = tree.prefixRange(words.word[1]);
+            appendRange(output, first, last, limit, scratch);
+        }
+        else if (command == "PREREQS") {
+            if (words.count != 2) {
+                appendError(output, "usage: PREREQS <number>");
+                continue;
+            }
+            std::uint32_t id = graph.idOf(words.word[1]);
+            if (id == PrerequisiteGraph::npos) {
+                appendError(output, "unknown course");
+                continue;
+            }
+            std::vector<std::uint32_t> chain = graph.allPrerequisites(id);
+            appendHeader(output, chain.size());
+            for (std::uint32_t prereq : chain)
+                appendRecord(output, graph.course(prereq));
+        }
+        else if (command == "PING" || command == "QUIT") {
+            appendHeader(output, 0);
+        }
+        else {
+            appendError(output, "unknown request");
+        }
+    }
+    return used;
+}
+
+/*
+* serveStream: One read, one handle, one write: responses to everything that arrived together
+*              leave in a single write. A partial line waits for the next read; input that ends
+*              without a newline is answered as a last line.
+*/
+void CatalogServer::serveStream(int inFd, int outFd) const {
+#ifndef _WIN32
+    std::signal(SIGPIPE, SIG_IGN);  // a client hanging up shows as a failed write instead
+#endif
+    std::vector<char> chunk(64 * 1024);
+    std::string pending;
+    std::string output;
+    bool quit = false;
+    bool discarding = false;    // skipping the rest of an overlong line
+    while (!quit) {
+        long n = readSome(inFd, chunk.data(), chunk.size());
+        if (n <= 0) {
+            if (pending.empty() || discarding)
+                break;
+            pending += '\n';
+        }
+        else {
+            pending.append(chunk.data(), static_cast<std::size_t>(n));
+        }
+        if (discarding) {
+            std::size_t newline = pending.find('\n');
+            if (newline == std::string::npos) {
+                pending.clear();
+                continue;
+            }
+            pending.erase(0, newline + 1);
+            discarding = false;
+        }
+
+        pending.erase(0, handle(pending, output, quit));
+        if (!quit && pending.size() > maxLineLength) {
+            appendError(output, "request too long");
+            pending.clear();
+            discarding = true;
+        }
+        if (!output.empty()) {
+            if (!writeAll(outFd, output))
+                break;
+            output.clear();
+        }
+        if (n <= 0)
+            break;
+    }
+}
+
+bool CatalogServer::serveSocket(const std::string& path) const {
+#ifdef _WIN32
+    std::cerr << "Unix domain sockets are not supported on this platform; use --serve without --socket." << std::endl;
+    (void)path;
+    return false;
+#else
+    std::signal(SIGPIPE, SIG_IGN);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // A socket file left by an earlier run would make bind fail; anything else is left alone.
+    struct stat existing;
+    if (::stat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+        ::unlink(path.c_str());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+        if (listener >= 0)
+            ::close(listener);
+        return false;
+    }
+    std::cerr << "Serving " << tree.size() << " courses on " << path << std::endl;
+
+    // Every connection thread is joined before this returns, so none can outlive the tree and
+    // graph it reads. The acceptor closes each socket after joining its thread, which keeps
+    // the descriptor valid for the shutdown below.
+    struct Connection {
+        int fd;
+        std::thread thread;
+        std::atomic<bool> finished{ false };
+    };
+    std::list<Connection> connections;
+    auto reapFinished = [&connections]() {
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (!it->finished.load(std::memory_order_acquire)) {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            ::close(it->fd);
+            it = connections.erase(it);
+        }
+    };
+
+    bool backingOff = false;
+    for (;;) {
+        int client = ::accept(listener, nullptr, nullptr);
+        reapFinished();
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            // Out of descriptors or memory: wait for connections to close instead of giving up.
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                if (!backingOff)
+                    std::cerr << "accept failed, retrying: " << std::strerror(errno) << std::endl;
+                backingOff = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            std::cerr << "accept failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        backingOff = false;
+        Connection& connection = connections.emplace_back();
+        connection.fd = client;
+        connection.thread = std::thread([this, &connection]() {
+            serveStream(connection.fd, connection.fd);
+            connection.finished.store(true, std::memory_order_release);
+        });
+    }
+
+    // Wake the remaining connections (their reads see end of input) and wait for them.
+    for (Connection& connection : connections)
+        ::shutdown(connection.fd, SHUT_RDWR);
+    for (Connection& connection : connections) {
+        connection.thread.join();
+        ::close(connection.fd);
+    }
+    ::close(listener);
+    return false;
+#endif
+}
@@ -0,0 +1,67 @@
+/*
+    File: CatalogServer.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: CatalogServer
+    Description: Headless request server for a loaded catalog, over stdin/stdout or a Unix
+                 domain socket
+*/
+#ifndef CATALOG_SERVER_H
+#define CATALOG_SERVER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "Course.h"
+#include "PrerequisiteGraph.h"
+
+/*
+* Class: CatalogServer
+* Description: Answers a line-based request protocol against a loaded tree. Each request is one
+*              line; clients may send many before reading (pipelining), and responses come back
+*              in request order:
+*
+*                  LOOKUP <number>              the course, if any
+*                  RANGE <from> <to> [limit]    courses with from <= number < to
+*                  PREFIX <prefix> [limit]      courses whose number starts with prefix
+*                  PREREQS <number>             the course's full prerequisite chain
+*                  PING                         no records
+*                  QUIT                         no records, then closes the connection
+*
+*              Every response is a header line "OK <count>" followed by count records in the
+*              catalog's CSV form (number,title,prerequisites...), or a single "ERR <message>"
+*              line. Blank lines are ignored. All complete lines from one read are answered
+*              together: their lookups run as one RedBlackTree::searchBatch, and the responses
+*              go out in a single write. The tree and graph are only read, so one server can
+*              serve many connections at once as long as nothing modifies the tree meanwhile.
+*/
+class CatalogServer {
+public:
+    // The graph must have been built from tree.
+    CatalogServer(const RedBlackTree& tree, const PrerequisiteGraph& graph);
+
+    // Answers every complete line in input, appending the responses to output. Returns the
+    // number of bytes used (up to and including the last newline handled). Sets quit, and
+    // stops there, when a QUIT request is reached.
+    std::size_t handle(std::string_view input, std::string& output, bool& quit) const;
+
+    // Serves requests read from inFd and writes responses to outFd until end of input, QUIT,
+    // or a write error. Works for pipes, terminals and sockets.
+    void serveStream(int inFd, int outFd) const;
+
+    // Listens on a Unix domain socket at path (replacing a stale socket file) and serves each
+    // connection on its own thread. Running out of descriptors or memory pauses accepting
+    // until connections close. Only returns (false) if the socket cannot be set up, which
+    // includes platforms without Unix domain sockets, or accept fails for good; every
+    // connection thread has been shut down and joined by then.
+    bool serveSocket(const std::string& path) const;
+
+private:
+    // Longest request line accepted; a longer one is answered with ERR and discarded.
+    static constexpr std::size_t maxLineLength = 64 * 1024;
+
+    const RedBlackTree& tree;
+    const PrerequisiteGraph& graph;
+};
+
+#endif
@@ -0,0 +1,259 @@
+/*
+    File: CatalogSnapshot.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Writing, validating and querying binary catalog snapshots
+*/
+
+#include "CatalogSnapshot.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+    const char snapshotMagic[8] = { 'A', 'B', 'C', 'U', 'C', 'A', 'T', '\0' };
+    constexpr std::uint32_t nativeByteOrderMark = 0x01020304;
+
+    // Rebuilds the CourseKey that was packed into a record.
+    CourseKey recordKey(const SnapshotRecord& record) {
+        CourseKey key;
+        key.packed = record.packedKey;
+        key.overflow = record.number.length > 8;
+        return key;
+    }
+
+    bool inside(const SnapshotString& s, std::uint64_t stringBytes) {
+        return static_cast<std::uint64_t>(s.offset) + s.length <= stringBytes;
+    }
+
+    /*
+    * validateSections: Checks everything the accessors trust without rechecking: every string
+    *                   lies inside the string section, every prerequisite run inside the
+    *                   reference section, and the records carry their own packed keys in
+    *                   course-number order, so find's binary search holds. Returns null if
+    *                   all of that holds, otherwise what is wrong.
+    */
+    const char* validateSections(const SnapshotHeader& header, const SnapshotRecord* records,
+                                 const SnapshotString* prerequisites, const char* strings) {
+        for (std::uint64_t i = 0; i < header.prerequisiteCount; ++i) {
+            if (!inside(prerequisites[i], header.stringBytes))
+                return "a prerequisite name lies outside the string section";
+        }
+        for (std::uint64_t i = 0; i < header.courseCount; ++i) {
+            const SnapshotRecord& record = records[i];
+            if (!inside(record.number, header.stringBytes) || !inside(record.title, header.stringBytes))
+                return "a course string lies outside the string section";
+            if (static_cast<std::uint64_t>(record.firstPrerequisite) + record.prerequisiteCount > header.prerequisiteCount)
+                return "a course's prerequisites lie outside the prerequisite section";
+            std::string_view number(strings + record.number.offset, record.number.length);
+            if (record.packedKey != CourseKey(number).packed)
+                return "a packed key does not match its course number";
+            if (i > 0) {
+                const SnapshotRecord& previous = records[i - 1];
+                std::string_view previousNumber(strings + previous.number.offset, previous.number.length);
+                if (compareCourseKeys(recordKey(previous), previousNumber, recordKey(record), number) > 0)
+                    return "the courses are out of order";
+            }
+        }
+        return nullptr;
+    }
+}
+
+/*
+* snapshotChecksum: FNV-1a applied to whole 64-bit words, which is several times faster than
+*                   the byte-wise form on large snapshots.
+*/
+std::uint64_t snapshotChecksum(const char* data, std::size_t length) {
+    std::uint64_t hash = 14695981039346656037ull;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    if (i < length) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + i, length - i);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/*
+* writeCatalogSnapshot: Lays out records, prerequisite references and strings in one buffer,
+*                       checksums it and writes header plus body.
+*/
+bool writeCatalogSnapshot(const RedBlackTree& tree, const std::string& fileName) {
+    std::vector<SnapshotRecord> records;
+    std::vector<SnapshotString> prerequisites;
+    std::string strings;
+    records.reserve(tree.size());
+    bool tooLarge = false;
+
+    auto addString = [&](const std::string& value) {
+        SnapshotString s{ static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(value.size()) };
+        if (strings.size() + value.size() > std::numeric_limits<std::uint32_t>::max())
+            tooLarge = true;
+        strings += value;
+        return s;
+    };
+
+    tree.forEachInOrder([&](const Course& course) {
+        SnapshotRecord record;
+        record.packedKey = CourseKey(course.courseNumber).packed;
+        record.number = addString(course.courseNumber);
+        record.title = addString(course.courseTitle);
+        record.firstPrerequisite = static_cast<std::uint32_t>(prerequisites.size());
+        record.prerequisiteCount = static_cast<std::uint32_t>(course.prerequisites.size());
+        for (const auto& prereq : course.prerequisites)
+            prerequisites.push_back(addString(prereq));
+        records.push_back(record);
+    });
+    if (tooLarge || prerequisites.size() > std::numeric_limits<std::uint32_t>::max()) {
+        std::cerr << "Error: Catalog is too large for snapshot format version "
+                  << CatalogSnapshot::currentFormatVersion << std::endl;
+        return false;
+    }
+
+    std::size_t recordBytes = records.size() * sizeof(SnapshotRecord);
+    std::size_t prerequisiteBytes = prerequisites.size() * sizeof(SnapshotString);
+    std::vector<char> body(recordBytes + prerequisiteBytes + strings.size());
+    if (recordBytes)
+        std::memcpy(body.data(), records.data(), recordBytes);
+    if (prerequisiteBytes)
+        std::memcpy(body.data() + recordBytes, prerequisites.data(), prerequisiteBytes);
+    if (!strings.empty())
+        std::memcpy(body.data() + recordBytes + prerequisiteBytes, strings.data(), strings.size());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.formatVersion = CatalogSnapshot::currentFormatVersion;
+    header.byteOrderMark = nativeByteOrderMark;
+    header.courseCount = records.size();
+    header.prerequisiteCount = prerequisites.size();
+    header.stringBytes = strings.size();
+    header.checksum = snapshotChecksum(body.data(), body.size());
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to open the file: " << fileName << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(body.data(), static_cast<std::streamsize>(body.size()));
+    if (!out) {
+        std::cerr << "Error: Could not write snapshot " << fileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* open: Maps the file and checks magic, version, byte order, section sizes, (optionally) the
+*       checksum and then every record before exposing any of it. The record pass always runs:
+*       the checksum catches accidental damage, but it is no defence against a crafted file.
+*/
+bool CatalogSnapshot::open(const std::string& fileName, bool verifyChecksum) {
+    header = nullptr;
+    records = nullptr;
+    prerequisites = nullptr;
+    strings = nullptr;
+    if (!file.open(fileName)) {
+        std::cerr << "Failed to open the file: " << fileName << std::endl;
+        return false;
+    }
+    std::string_view data = file.view();
+    const SnapshotHeader* candidate = reinterpret_cast<const SnapshotHeader*>(data.data());
+    if (data.size() < sizeof(SnapshotHeader) || std::memcmp(candidate->magic, snapshotMagic, sizeof(snapshotMagic)) != 0) {
+        std::cerr << "Error: " << fileName << " is not a catalog snapshot" << std::endl;
+        file.close();
+        return false;
+    }
+    if (candidate->byteOrderMark != nativeByteOrderMark) {
+        std::cerr << "Error: " << fileName << " was written on a machine with a different byte order" << std::endl;
+        file.close();
+        return false;
+    }
+    if (candidate->formatVersion != currentFormatVersion) {
+        std::cerr << "Error: " << fileName << " uses snapshot format version " << candidate->formatVersion
+                  << "; expected version " << currentFormatVersion << std::endl;
+        file.close();
+        return false;
+    }
+    // Each count is bounded by the bytes present before it is multiplied, so a crafted header
+    // cannot wrap the expected size around to match the file.
+    std::uint64_t available = data.size() - sizeof(SnapshotHeader);
+    bool fits = candidate->courseCount <= available / sizeof(SnapshotRecord)
+        && candidate->prerequisiteCount <= available / sizeof(SnapshotString)
+        && candidate->stringBytes <= available;
+    if (!fits || candidate->courseCount * sizeof(SnapshotRecord) + candidate->prerequisiteCount * sizeof(SnapshotString)
+        + candidate->stringBytes != available) {
+        std::cerr << "Error: Snapshot " << fileName << " is truncated or has trailing data" << std::endl;
+        file.close();
+        return false;
+    }
+    const char* body = data.data() + sizeof(SnapshotHeader);
+    if (verifyChecksum && snapshotChecksum(body, data.size() - sizeof(SnapshotHeader)) != candidate->checksum) {
+        std::cerr << "Error: Snapshot " << fileName << " failed its checksum" << std::endl;
+        file.close();
+        return false;
+    }
+    const SnapshotRecord* candidateRecords = reinterpret_cast<const SnapshotRecord*>(body);
+    const SnapshotString* candidatePrerequisites =
+        reinterpret_cast<const SnapshotString*>(body + candidate->courseCount * sizeof(SnapshotRecord));
+    const char* candidateStrings = body + candidate->courseCount * sizeof(SnapshotRecord)
+        + candidate->prerequisiteCount * sizeof(SnapshotString);
+    if (const char* problem = validateSections(*candidate, candidateRecords, candidatePrerequisites, candidateStrings)) {
+        std::cerr << "Error: Snapshot " << fileName << " is corrupt: " << problem << std::endl;
+        file.close();
+        return false;
+    }
+    header = candidate;
+    records = candidateRecords;
+    prerequisites = candidatePrerequisites;
+    strings = candidateStrings;
+    return true;
+}
+
+/*
+* find: Binary search on the packed keys stored in the records.
+*/
+std::size_t CatalogSnapshot::find(std::string_view courseNumber) const {
+    CourseKey key(courseNumber);
+    std::size_t lo = 0;
+    std::size_t hi = size();
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        int cmp = compareCourseKeys(key, courseNumber, recordKey(records[mid]), text(records[mid].number));
+        if (cmp == 0)
+            return mid;
+        if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return npos;
+}
+
+/*
+* toCourse: Materializes one record as an owning Course.
+*/
+Course CatalogSnapshot::toCourse(std::size_t index) const {
+    Course course{ std::string(courseNumber(index)), std::string(courseTitle(index)) };
+    course.prerequisites.reserve(prerequisiteCount(index));
+    for (std::size_t i = 0; i < prerequisiteCount(index); ++i)
+        course.prerequisites.emplace_back(prerequisite(index, i));
+    return course;
+}
+
+/*
+* search: Lookup with the same result type as RedBlackTree::search.
+*/
+std::optional<Course> CatalogSnapshot::search(std::string_view courseNumber) const {
+    std::size_t index = find(courseNumber);
+    if (index == npos)
+        return std::nullopt;
+    return toCourse(index);
+}
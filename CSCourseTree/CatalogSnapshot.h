@@ -0,0 +1,110 @@
+/*
+    File: CatalogSnapshot.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: CatalogSnapshot, SnapshotHeader, SnapshotRecord
+    Description: Versioned, checksummed binary catalog image that is queried straight from a memory mapping
+*/
+#ifndef CATALOG_SNAPSHOT_H
+#define CATALOG_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Course.h"
+#include "CsvLoader.h"
+
+/*
+* File layout (every section 8-byte aligned). Integers are stored in the writer's native byte
+* order, which byteOrderMark records; open() rejects a file written with the other byte order.
+*   SnapshotHeader                       64 bytes
+*   SnapshotRecord[courseCount]          sorted by course number
+*   SnapshotString[prerequisiteCount]    prerequisite names, grouped per course
+*   string bytes                         course numbers, titles and prerequisite names
+* The checksum covers everything after the header.
+*/
+struct SnapshotHeader {
+    char magic[8];                      // "ABCUCAT" + NUL
+    std::uint32_t formatVersion;
+    std::uint32_t byteOrderMark;        // 0x01020304 as written by the producing machine
+    std::uint64_t courseCount;
+    std::uint64_t prerequisiteCount;
+    std::uint64_t stringBytes;
+    std::uint64_t checksum;
+    std::uint64_t reserved[2];
+};
+
+// Offset and length of one string inside the string section.
+struct SnapshotString {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// One course. The packed key lets binary search run without touching the string section.
+struct SnapshotRecord {
+    std::uint64_t packedKey;
+    SnapshotString number;
+    SnapshotString title;
+    std::uint32_t firstPrerequisite;
+    std::uint32_t prerequisiteCount;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader layout changed");
+static_assert(sizeof(SnapshotRecord) == 32, "SnapshotRecord layout changed");
+
+// Writes the tree to fileName as a snapshot. Returns false (after printing why) on failure.
+bool writeCatalogSnapshot(const RedBlackTree& tree, const std::string& fileName);
+
+/*
+* Class: CatalogSnapshot
+* Description: Read-only view of a snapshot file. Opening maps the file and validates the
+*              header, every record's string and prerequisite ranges and key order (and
+*              optionally the checksum) in one pass; nothing is parsed or allocated per
+*              course. Courses are addressed by index in course-number order, and every
+*              string returned points into the mapping, valid while the snapshot is open.
+*/
+class CatalogSnapshot {
+public:
+    static constexpr std::uint32_t currentFormatVersion = 1;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    CatalogSnapshot() = default;
+
+    // Maps and validates a snapshot. Returns false (after printing why) if it is unusable.
+    bool open(const std::string& fileName, bool verifyChecksum = true);
+
+    // Number of courses.
+    std::size_t size() const { return header ? static_cast<std::size_t>(header->courseCount) : 0; }
+
+    // Index of the course with this number, or npos.
+    std::size_t find(std::string_view courseNumber) const;
+
+    std::string_view courseNumber(std::size_t index) const { return text(records[index].number); }
+    std::string_view courseTitle(std::size_t index) const { return text(records[index].title); }
+    std::size_t prerequisiteCount(std::size_t index) const { return records[index].prerequisiteCount; }
+
+    std::string_view prerequisite(std::size_t index, std::size_t which) const {
+        return text(prerequisites[records[index].firstPrerequisite + which]);
+    }
+
+    // Copies one course out of the snapshot.
+    Course toCourse(std::size_t index) const;
+
+    // Same contract as RedBlackTree::search.
+    std::optional<Course> search(std::string_view courseNumber) const;
+
+private:
+    MappedFile file;
+    const SnapshotHeader* header = nullptr;
+    const SnapshotRecord* records = nullptr;
+    const SnapshotString* prerequisites = nullptr;
+    const char* strings = nullptr;
+
+    std::string_view text(const SnapshotString& s) const { return std::string_view(strings + s.offset, s.length); }
+};
+
+// 64-bit FNV-1a over 8-byte words (the tail is zero padded), used for the snapshot checksum.
+std::uint64_t snapshotChecksum(const char* data, std::size_t length);
+
+#endif
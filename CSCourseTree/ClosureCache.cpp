@@ -0,0 +1,336 @@
+/*
+    File: ClosureCache.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: ClosureCache
+    Description: Link maintenance, dependent invalidation and delta-encoded closure building
+*/
+
+#include "ClosureCache.h"
+#include <algorithm>
+
+namespace {
+    // Non-base prerequisites are looked for this far into the base's closure before falling
+    // back to building the union with marks; chains put near prerequisites first.
+    constexpr std::size_t containsBudget = 64;
+}
+
+std::uint32_t ClosureCache::idFor(const std::string& number) {
+    auto it = ids.find(number);
+    if (it != ids.end())
+        return it->second;
+    std::uint32_t id = static_cast<std::uint32_t>(entries.size());
+    entries.emplace_back();
+    ids.emplace(number, id);
+    order.push_back(0);
+    low.push_back(0);
+    onStack.push_back(0);
+    marks.push_back(0);
+    return id;
+}
+
+std::uint32_t ClosureCache::idOf(const std::string& number) const {
+    auto it = ids.find(number);
+    return it == ids.end() ? npos : it->second;
+}
+
+/*
+* relink: Replaces the entry's outgoing links and the matching dependent links on the other
+*         side. Prerequisites without a stored course still get an entry, so adding that
+*         course later finds (and invalidates) the courses that were waiting for it.
+*/
+void ClosureCache::relink(std::uint32_t id) {
+    for (std::uint32_t prereq : entries[id].prereqs) {
+        auto& dependents = entries[prereq].dependents;
+        auto it = std::find(dependents.begin(), dependents.end(), id);
+        if (it != dependents.end()) {
+            *it = dependents.back();
+            dependents.pop_back();
+        }
+    }
+    std::vector<std::uint32_t> prereqs;
+    if (const Course* course = entries[id].course()) {
+        for (const auto& name : course->prerequisites)
+            prereqs.push_back(idFor(name));     // may grow entries; index again below
+        std::sort(prereqs.begin(), prereqs.end());
+        prereqs.erase(std::unique(prereqs.begin(), prereqs.end()), prereqs.end());
+    }
+    for (std::uint32_t prereq : prereqs)
+        entries[prereq].dependents.push_back(id);
+    entries[id].prereqs = std::move(prereqs);
+}
+
+void ClosureCache::forget(Entry& entry) {
+    if (!entry.valid)
+        return;
+    entry.valid = false;
+    deltaIds -= entry.delta.size();
+    entry.delta.clear();        // keeps its capacity for the recompute that usually follows
+    entry.base = npos;
+    entry.size = 0;
+    --memoized;
+    ++invalidated;
+}
+
+/*
+* invalidate: Depth-first over dependents with an explicit stack. Entries that are already
+*             invalid are not expanded: none of their dependents can be valid. The changed
+*             entry itself always is, since it may be a course that was missing until now,
+*             which valid closures were built without.
+*/
+void ClosureCache::invalidate(std::uint32_t id) {
+    forget(entries[id]);
+    std::vector<std::uint32_t> stack(entries[id].dependents);
+    while (!stack.empty()) {
+        Entry& entry = entries[stack.back()];
+        stack.pop_back();
+        if (!entry.valid)
+            continue;
+        forget(entry);
+        stack.insert(stack.end(), entry.dependents.begin(), entry.dependents.end());
+    }
+}
+
+void ClosureCache::courseAdded(const Course& course) {
+    std::uint32_t id = idFor(course.courseNumber);
+    auto& records = entries[id].records;
+    records.push_back(&course);
+    if (records.size() > 1)
+        return;     // a later duplicate; the record in use is unchanged
+    invalidate(id);
+    relink(id);
+}
+
+void ClosureCache::courseRemoved(const Course& course) {
+    std::uint32_t id = idOf(course.courseNumber);
+    if (id == npos)
+        return;
+    auto& records = entries[id].records;
+    auto it = std::find(records.begin(), records.end(), &course);
+    if (it == records.end())
+        return;
+    bool inUse = it == records.begin();
+    records.erase(it);
+    if (!inUse)
+        return;
+    invalidate(id);
+    relink(id);
+}
+
+void ClosureCache::cleared() {
+    entries.clear();
+    ids.clear();
+    order.clear();
+    low.clear();
+    onStack.clear();
+    marks.clear();
+    memoized = 0;
+    deltaIds = 0;
+}
+
+void ClosureCache::nextMarkPass() {
+    if (++markPass == 0) {
+        std::fill(marks.begin(), marks.end(), 0);
+        markPass = 1;
+    }
+}
+
+bool ClosureCache::closureContains(std::uint32_t id, std::uint32_t target, std::size_t budget) const {
+    for (std::uint32_t x = id; x != npos && budget > 0; x = entries[x].base) {
+        for (std::uint32_t member : entries[x].delta) {
+            if (member == target)
+                return true;
+            if (--budget == 0)
+                break;
+        }
+    }
+    return false;
+}
+
+void ClosureCache::markClosure(std::uint32_t id) {
+    for (std::uint32_t x = id; x != npos; x = entries[x].base)
+        for (std::uint32_t member : entries[x].delta)
+            marks[member] = markPass;
+}
+
+/*
+* addMarked: If id is already marked, its closure is too (it came in with a closure that holds
+*            it, and closures are transitive), so the whole contribution is skipped.
+*/
+void ClosureCache::addMarked(std::uint32_t id, std::vector<std::uint32_t>& set) {
+    if (marks[id] == markPass)
+        return;
+    marks[id] = markPass;
+    set.push_back(id);
+    for (std::uint32_t x = id; x != npos; x = entries[x].base) {
+        for (std::uint32_t member : entries[x].delta) {
+            if (marks[member] != markPass) {
+                marks[member] = markPass;
+                set.push_back(member);
+            }
+        }
+    }
+}
+
+/*
+* computeSingle: The base is the prerequisite with the largest closure. Another prerequisite
+*                found near the top of the base's closure adds nothing (its closure is inside
+*                the base's); the rest are merged in with marks, which are only set up once
+*                such a prerequisite turns up.
+*/
+void ClosureCache::computeSingle(std::uint32_t id) {
+    Entry& entry = entries[id];
+    std::uint32_t base = npos;
+    for (std::uint32_t prereq : entry.prereqs) {
+        if (entries[prereq].course() && (base == npos || entries[prereq].size > entries[base].size))
+            base = prereq;
+    }
+
+    entry.delta.clear();
+    if (base != npos) {
+        entry.delta.push_back(base);
+        bool marked = false;
+        for (std::uint32_t prereq : entry.prereqs) {
+            if (prereq == base || !entries[prereq].course() || closureContains(base, prereq, containsBudget))
+                continue;
+            if (!marked) {
+                nextMarkPass();
+                marks[base] = markPass;
+                markClosure(base);
+                marked = true;
+            }
+            addMarked(prereq, entry.delta);
+        }
+    }
+
+    entry.base = base;
+    entry.size = entry.delta.size() + (base != npos ? entries[base].size : 0);
+    entry.valid = true;
+    deltaIds += entry.delta.size();
+    ++memoized;
+    ++computed;
+}
+
+/*
+* computeCycle: Every member reaches every other, so all share one set: the members plus the
+*               closures of their prerequisites outside the cycle. Each member stores it in full
+*               (minus itself); cycles are rare and small.
+*/
+void ClosureCache::computeCycle(const std::vector<std::uint32_t>& members) {
+    nextMarkPass();
+    std::vector<std::uint32_t> shared;
+    for (std::uint32_t member : members) {
+        marks[member] = markPass;
+        shared.push_back(member);
+    }
+    for (std::uint32_t member : members) {
+        for (std::uint32_t prereq : entries[member].prereqs) {
+            if (entries[prereq].course())
+                addMarked(prereq, shared);
+        }
+    }
+    for (std::uint32_t member : members) {
+        Entry& entry = entries[member];
+        entry.base = npos;
+        entry.delta.clear();
+        entry.delta.reserve(shared.size() - 1);
+        for (std::uint32_t other : shared) {
+            if (other != member)
+                entry.delta.push_back(other);
+        }
+        entry.size = entry.delta.size();
+        entry.valid = true;
+        deltaIds += entry.delta.size();
+        ++memoized;
+        ++computed;
+    }
+}
+
+/*
+* ensure: Iterative Tarjan over the invalid part of the graph below id. Valid closures and
+*         courses that are not stored are leaves. Components come off in prerequisite-first
+*         order, so each is computed after everything it is built from.
+*/
+void ClosureCache::ensure(std::uint32_t id) {
+    if (entries[id].valid || !entries[id].course())
+        return;
+    struct Frame {
+        std::uint32_t id;
+        std::size_t next;   // next prerequisite to look at
+    };
+    std::vector<Frame> frames;
+    std::vector<std::uint32_t> stack;       // Tarjan's component stack
+    std::vector<std::uint32_t> visited;     // to reset order afterwards
+    std::vector<std::uint32_t> component;
+    std::uint32_t counter = 0;
+
+    auto visit = [&](std::uint32_t v) {
+        order[v] = low[v] = ++counter;
+        visited.push_back(v);
+        stack.push_back(v);
+        onStack[v] = 1;
+        frames.push_back({ v, 0 });
+    };
+    visit(id);
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        const Entry& entry = entries[frame.id];
+        if (frame.next < entry.prereqs.size()) {
+            std::uint32_t prereq = entry.prereqs[frame.next++];
+            if (entries[prereq].valid || !entries[prereq].course())
+                continue;
+            if (order[prereq] == 0)
+                visit(prereq);  // invalidates frame
+            else if (onStack[prereq])
+                low[frame.id] = std::min(low[frame.id], order[prereq]);
+            continue;
+        }
+
+        std::uint32_t v = frame.id;
+        frames.pop_back();
+        if (!frames.empty())
+            low[frames.back().id] = std::min(low[frames.back().id], low[v]);
+        if (low[v] != order[v])
+            continue;
+        component.clear();
+        std::uint32_t member;
+        do {
+            member = stack.back();
+            stack.pop_back();
+            onStack[member] = 0;
+            component.push_back(member);
+        } while (member != v);
+        const auto& prereqs = entries[v].prereqs;
+        if (component.size() == 1 && !std::binary_search(prereqs.begin(), prereqs.end(), v))
+            computeSingle(v);
+        else
+            computeCycle(component);
+    }
+    for (std::uint32_t v : visited)
+        order[v] = 0;
+}
+
+void ClosureCache::allPrerequisites(const std::string& courseNumber, std::vector<const Course*>& out) {
+    std::uint32_t id = idOf(courseNumber);
+    if (id == npos || !entries[id].course())
+        return;
+    ensure(id);
+    out.reserve(out.size() + entries[id].size);
+    for (std::uint32_t x = id; x != npos; x = entries[x].base)
+        for (std::uint32_t member : entries[x].delta)
+            out.push_back(entries[member].course());
+}
+
+std::vector<const Course*> ClosureCache::allPrerequisites(const std::string& courseNumber) {
+    std::vector<const Course*> out;
+    allPrerequisites(courseNumber, out);
+    return out;
+}
+
+std::size_t ClosureCache::closureSize(const std::string& courseNumber) {
+    std::uint32_t id = idOf(courseNumber);
+    if (id == npos || !entries[id].course())
+        return 0;
+    ensure(id);
+    return entries[id].size;
+}
@@ -0,0 +1,146 @@
+/*
+    File: ClosureCache.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: ClosureCache
+    Description: Memoized transitive prerequisite sets, kept correct by invalidating only the
+                 dependents of courses that change
+*/
+#ifndef CLOSURE_CACHE_H
+#define CLOSURE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Course.h"
+
+/*
+* Class: ClosureCache
+* Description: Answers "everything required before this course" from memoized results. Attach
+*              it with RedBlackTree::addObserver; it keeps its own prerequisite and dependent
+*              links, keyed by course number, as courses are stored and removed.
+*
+*              A closure is computed on first request and stored as a delta: the prerequisite
+*              with the largest closure becomes its base, and only the courses that base does
+*              not already cover are kept. For overlapping chains (CSCI300 requires CSCI200,
+*              which requires CSCI100, ...) each course adds one or two IDs, instead of a full
+*              copy of the chain below it. Reading a closure walks the base chain and copies
+*              each delta once, so a warm query is O(result size).
+*
+*              When a course is stored, replaced or removed, its closure and those of every
+*              course that transitively requires it are dropped, and nothing else. A course
+*              whose closure is invalid never has valid dependents, so the walk stops at
+*              courses that are already invalid. Closures are rebuilt bottom-up with an
+*              iterative strongly-connected-components pass, so deep chains do not recurse and
+*              prerequisite cycles are handled (every member of a cycle requires the others).
+*
+*              Like PrerequisiteGraph, a course is not part of its own closure, and
+*              prerequisite names that match no stored course are left out until such a course
+*              is added. A number stored more than once uses the earliest of its records that is
+*              still stored, as PrerequisiteGraph resolves duplicates to the first one.
+*              Queries fill the cache, so the cache is not safe to query from several threads.
+*/
+class ClosureCache : public CourseObserver {
+public:
+    ClosureCache() = default;
+
+    // Entries point at the tree's courses, so the cache is not copied.
+    ClosureCache(const ClosureCache&) = delete;
+    ClosureCache& operator=(const ClosureCache&) = delete;
+
+    // CourseObserver: called by the tree as courses are stored, removed and cleared.
+    void courseAdded(const Course& course) override;
+    void courseRemoved(const Course& course) override;
+    void cleared() override;
+
+    // Every course courseNumber transitively requires, each once, nearest first along the
+    // chain of bases. Empty if the course is not stored. The pointers are the tree's courses.
+    std::vector<const Course*> allPrerequisites(const std::string& courseNumber);
+
+    // Same, appending to out instead of allocating a new vector.
+    void allPrerequisites(const std::string& courseNumber, std::vector<const Course*>& out);
+
+    // Size of the closure (computing it if needed); 0 if the course is not stored.
+    std::size_t closureSize(const std::string& courseNumber);
+
+    // Courses whose closure is currently memoized.
+    std::size_t memoizedCount() const { return memoized; }
+
+    // Course IDs held across all stored deltas: the cache's memory, in four-byte entries.
+    std::size_t storedIds() const { return deltaIds; }
+
+    // Closures computed so far, and closures dropped because something below them changed.
+    std::size_t computeCount() const { return computed; }
+    std::size_t invalidationCount() const { return invalidated; }
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    struct Entry {
+        std::vector<const Course*> records;     // stored courses with this number, oldest first
+        std::vector<std::uint32_t> prereqs;     // distinct direct prerequisites (of the oldest record)
+        std::vector<std::uint32_t> dependents;  // courses listing this one as a direct prerequisite
+        bool valid = false;                     // closure below is current
+        std::uint32_t base = npos;              // closure = base + base's closure + delta
+        std::vector<std::uint32_t> delta;
+        std::size_t size = 0;                   // closure size
+
+        const Course* course() const { return records.empty() ? nullptr : records.front(); }
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, std::uint32_t> ids;     // course number -> entry
+    std::size_t memoized = 0;
+    std::size_t deltaIds = 0;
+    std::size_t computed = 0;
+    std::size_t invalidated = 0;
+
+    // Scratch for rebuilding, indexed by entry. order is 0 for entries the current pass has
+    // not visited; marks equal to markPass are in the set being built.
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> low;
+    std::vector<unsigned char> onStack;
+    std::vector<std::uint32_t> marks;
+    std::uint32_t markPass = 0;
+
+    // The ID for a number, creating an entry (with no records) if needed.
+    std::uint32_t idFor(const std::string& number);
+
+    // The ID for a number, or npos if it has no entry.
+    std::uint32_t idOf(const std::string& number) const;
+
+    // Points the entry's prerequisite links at its oldest record's list (or none).
+    void relink(std::uint32_t id);
+
+    // Drops the closures of id and of everything that transitively requires it.
+    void invalidate(std::uint32_t id);
+
+    // Clears an entry's memoized closure.
+    void forget(Entry& entry);
+
+    // Makes id's closure (and those it is built from) valid.
+    void ensure(std::uint32_t id);
+
+    // Builds the closure of one course that is not in a cycle; its prerequisites are valid.
+    void computeSingle(std::uint32_t id);
+
+    // Builds the closures of the members of one prerequisite cycle.
+    void computeCycle(const std::vector<std::uint32_t>& members);
+
+    // True if target is within the first budget IDs of id's closure (false means not found
+    // in that many, not that it is absent).
+    bool closureContains(std::uint32_t id, std::uint32_t target, std::size_t budget) const;
+
+    // Adds id and its closure to set, skipping IDs already marked and marking the rest.
+    void addMarked(std::uint32_t id, std::vector<std::uint32_t>& set);
+
+    // Marks every ID of id's closure (not id itself).
+    void markClosure(std::uint32_t id);
+
+    // Starts a new marked set, clearing the marks on wrap-around.
+    void nextMarkPass();
+};
+
+#endif
@@ -6,24 +6,100 @@
 */
 
 #include "Course.h"
+#include "CsvLoader.h"
+#include "FrozenCatalog.h"
 #include <sstream>
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
+#include <thread>
+
+// Instrumentation hooks; they compile to nothing unless COURSETREE_INSTRUMENTATION is defined.
+// Search steps, rotations, recolorings and fixup iterations are counted by the core's
+// TreeMetricsEvents.
+#ifdef COURSETREE_INSTRUMENTATION
+#define TREE_COUNT(counter, n) metrics.counter.fetch_add((n), std::memory_order_relaxed)
+#define TREE_LATENCY(histogram) ScopedLatency scopedLatency(metrics.histogram)
+#else
+#define TREE_COUNT(counter, n) ((void)0)
+#define TREE_LATENCY(histogram) ((void)0)
+#endif
 
 // Red-Black Tree constructor
-RedBlackTree::RedBlackTree() : root(nullptr) {}
+RedBlackTree::RedBlackTree() {
+    attachMetrics();
+}
+
+// Move constructor: takes over the other tree's nodes and observers.
+RedBlackTree::RedBlackTree(RedBlackTree&& other) noexcept
+    : core(std::move(other.core)), observers(std::move(other.observers)) {
+    other.observers.clear();
+    attachMetrics();
+}
+
+// Move assignment: releases this tree's nodes (clearing its observers, which are then detached)
+// and takes over the other tree's nodes and observers.
+RedBlackTree& RedBlackTree::operator=(RedBlackTree&& other) noexcept {
+    if (this != &other) {
+        for (CourseObserver* observer : observers)
+            observer->cleared();
+        core = std::move(other.core);
+        observers = std::move(other.observers);
+        other.observers.clear();
+        attachMetrics();
+    }
+    return *this;
+}
+
+/*
+* attachMetrics: The core's hooks point at this tree's counters, which stay put when the core
+*                is moved in from another tree.
+*/
+void RedBlackTree::attachMetrics() {
+#ifdef COURSETREE_INSTRUMENTATION
+    core.events().metrics = &metrics;
+#endif
+}
+
+/*
+* clear: Releases every node held by the core's arena.
+*/
+void RedBlackTree::clear() {
+    for (CourseObserver* observer : observers)
+        observer->cleared();
+    core.clear();
+}
+
+/*
+* addObserver: Replays the current contents into the new observer only, so it starts in sync
+*              without the others hearing about courses they already have.
+*/
+void RedBlackTree::addObserver(CourseObserver* observer) {
+    if (!observer || std::find(observers.begin(), observers.end(), observer) != observers.end())
+        return;
+    observers.push_back(observer);
+    observer->cleared();
+    forEachInOrder([observer](const Course& course) { observer->courseAdded(course); });
+}
+
+/*
+* removeObserver: Detaches without notifying; the rest keep their order.
+*/
+void RedBlackTree::removeObserver(CourseObserver* observer) {
+    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
 
 /*
 *  inOrderHelper: Recursively traverses the tree in order and print course info
 */
-void RedBlackTree::inOrderHelper(const std::shared_ptr<RBTreeNode>& node) const {
+void RedBlackTree::inOrderHelper(const CatalogTree::Node* node) const {
     if (node) {
         inOrderHelper(node->left);  // Traverse left subtree
 
         // Comment out to not print full course tree (testing)
-        std::cout << node->course.courseNumber << ": "
-            << node->course.courseTitle << " ("
+        std::cout << node->value.course.courseNumber << ": "
+            << node->value.course.courseTitle << " ("
             << (node->color == RED ? "Red" : "Black") << ")" << std::endl;
 
         inOrderHelper(node->right); // Traverse right subtree
@@ -34,239 +110,427 @@ void RedBlackTree::inOrderHelper(const std::shared_ptr<RBTreeNode>& node) const
 * Public inOrder: Initiates an in-order traversal
 */
 void RedBlackTree::inOrder() const {
-    inOrderHelper(root);
+    inOrderHelper(core.rootNode());
 }
 
 /*
-* leftRotate: Performs a left rotation on node x.
+* added: Shared by insert and emplace, which differ only in how the entry is constructed.
 */
-void RedBlackTree::leftRotate(std::shared_ptr<RBTreeNode> x) {
-    if (!x || !x->right) return;
-    auto y = x->right;           // Set y as x's right child
-    x->right = y->left;          // Move y's left subtree to become x's right subtree
-    if (y->left) {
-        // Update parent pointer of y's left child to x
-        y->left->parent = x;
-    }
+const Course& RedBlackTree::added(CatalogEntry& entry) {
+    TREE_COUNT(inserts, 1);
+    for (CourseObserver* observer : observers)
+        observer->courseAdded(entry.course);
+    return entry.course;
+}
 
-    // Link x's parent to y
-    if (auto xParent = x->parent.lock()) {
-        if (x.get() == xParent->left.get()) {
-            xParent->left = y;
-        }
-        else {
-            xParent->right = y;
-        }
-        y->parent = xParent;  // Assign parent's shared pointer to y's weak parent pointer
-    }
-    else {
-        // x was the root
-        root = y;
-        y->parent.reset();
-    }
+/*
+* eraseAt: The core relinks the successor rather than copying it, so pointers to every other
+*          course stay valid.
+*/
+void RedBlackTree::eraseAt(CatalogTree::iterator pos) {
+    TREE_COUNT(erases, 1);
+    for (CourseObserver* observer : observers)
+        observer->courseRemoved(pos->course);
+    core.erase(pos);
+}
 
-    // Put x as left child of y
-    y->left = x;
-    x->parent = y;  // Assign y (shared pointer) to x's weak parent pointer
+/*
+* erase: Removes a course by number.
+*/
+bool RedBlackTree::erase(std::string_view courseNumber) {
+    TREE_COUNT(searches, 1);
+    auto pos = core.find(PackedCourseNumber(courseNumber));
+    if (pos == core.end())
+        return false;
+    eraseAt(pos);
+    return true;
 }
 
 /*
-* rightRotate: Performs a right rotation on node x.
+* replaceCourse: The observers see the old course leave and the new one arrive at the same address.
 */
-void RedBlackTree::rightRotate(std::shared_ptr<RBTreeNode> x) {
-    if (!x || !x->left) return;
-    auto y = x->left;            // Set y as x's left child
-    x->left = y->right;          // Move y's right subtree to become x's left subtree
-    if (y->right) {
-        // Update parent pointer of y's right child to x
-        y->right->parent = x;
-    }
+void RedBlackTree::replaceCourse(CatalogEntry& entry, Course&& course) {
+    for (CourseObserver* observer : observers)
+        observer->courseRemoved(entry.course);
+    entry.course = std::move(course);
+    for (CourseObserver* observer : observers)
+        observer->courseAdded(entry.course);
+}
 
-    // Link x's parent to y
-    if (auto xParent = x->parent.lock()) {
-        if (x.get() == xParent->right.get()) {
-            xParent->right = y;
-        }
-        else {
-            xParent->left = y;
-        }
-        y->parent = xParent;
+/*
+* upsert: Overwrites the stored course when the number already exists (the key, and so the
+*         node's position, does not change); otherwise inserts it.
+*/
+bool RedBlackTree::upsert(const Course& course) {
+    TREE_COUNT(searches, 1);
+    if (CatalogEntry* entry = core.findValue(PackedCourseNumber(course.courseNumber))) {
+        replaceCourse(*entry, Course(course));
+        return false;
     }
-    else {
-        // x was the root
-        root = y;
-        y->parent.reset();
+    insert(course);
+    return true;
+}
+
+bool RedBlackTree::upsert(Course&& course) {
+    TREE_COUNT(searches, 1);
+    if (CatalogEntry* entry = core.findValue(PackedCourseNumber(course.courseNumber))) {
+        replaceCourse(*entry, std::move(course));
+        return false;
     }
+    insert(std::move(course));
+    return true;
+}
 
-    // Put x as right child of y
-    y->right = x;
-    x->parent = y;
+/*
+*  insert: Inserts a new course into the Red-Black Tree. Equal numbers go after the ones
+*          already stored, so duplicates keep insertion order.
+*/
+void RedBlackTree::insert(const Course& course) {
+    TREE_LATENCY(insertLatency);
+    added(core.emplace(course));
+}
+
+void RedBlackTree::insert(Course&& course) {
+    TREE_LATENCY(insertLatency);
+    added(core.emplace(std::move(course)));
 }
 
 /*
-* insertFixup: Restores the RedBlack Tree properties after a new node is inserted. This method
-*              handles three cases based on the color of the node's uncle and its relative position.
-*              It uses rotations (leftRotate and rightRotate) and recoloring to ensure that:
-*                 1. The root remains black.
-*                 2. Red nodes do not have red children.
-*                 3. Every path from a node to its descendant NIL nodes contains the same number of black nodes.
+* search: Public search method that searches for a course by course number and returns it if found.
 */
-void RedBlackTree::insertFixup(std::shared_ptr<RBTreeNode> z) {
-    // While the parent exists and is red (violating properties)
-    while (z->parent.lock() && z->parent.lock()->color == RED) {
-        auto zParent = z->parent.lock();
-        auto zGrandparent = zParent->parent.lock();
-        if (!zGrandparent)
-            break;  // Safety check
-        // If parent is the left child of grandparent
-        if (zParent == zGrandparent->left) {
-            auto y = zGrandparent->right; // y is z's uncle
-            if (y && y->color == RED) {
-                // Case 1: Uncle is red
-                zParent->color = BLACK;
-                y->color = BLACK;
-                zGrandparent->color = RED;
-                z = zGrandparent; // Move up the tree
-            }
-            else {
-                if (z.get() == zParent->right.get()) {
-                    // Case 2: z is a right child -> convert to Case 3
-                    z = zParent;
-                    leftRotate(z);
-                    zParent = z->parent.lock();
-                    zGrandparent = zParent ? zParent->parent.lock() : nullptr;
-                }
-                // Case 3: z is a left child
-                if (zParent)
-                    zParent->color = BLACK;
-                if (zGrandparent) {
-                    zGrandparent->color = RED;
-                    rightRotate(zGrandparent);
-                }
-            }
-        }
-        else {  // zParent is right child of zGrandparent
-            auto y = zGrandparent->left; // y is z's uncle
-            if (y && y->color == RED) {
-                // Case 1: Uncle is red
-                zParent->color = BLACK;
-                y->color = BLACK;
-                zGrandparent->color = RED;
-                z = zGrandparent; // Move up the tree
+std::optional<Course> RedBlackTree::search(std::string_view courseNumber) const {
+    if (const Course* course = find(courseNumber))
+        return *course;
+    return std::nullopt;
+}
+
+/*
+* find: Packs the number once and compares packed keys on the way down, only touching the
+*       strings for long numbers.
+*/
+const Course* RedBlackTree::find(std::string_view courseNumber) const {
+    TREE_LATENCY(searchLatency);
+    TREE_COUNT(searches, 1);
+    const CatalogEntry* entry = core.findValue(PackedCourseNumber(courseNumber));
+    return entry ? &entry->course : nullptr;
+}
+
+RedBlackTree::const_iterator RedBlackTree::lower_bound(std::string_view courseNumber) const {
+    return const_iterator(core.lower_bound(PackedCourseNumber(courseNumber)));
+}
+
+RedBlackTree::const_iterator RedBlackTree::upper_bound(std::string_view courseNumber) const {
+    return const_iterator(core.upper_bound(PackedCourseNumber(courseNumber)));
+}
+
+std::pair<RedBlackTree::const_iterator, RedBlackTree::const_iterator>
+RedBlackTree::equal_range(std::string_view courseNumber) const {
+    auto range = core.equal_range(PackedCourseNumber(courseNumber));
+    return { const_iterator(range.first), const_iterator(range.second) };
+}
+
+/*
+* prefixRange: Every number starting with prefix lies in [prefix, limit), where limit is the
+*              prefix with its last non-0xFF character incremented (and anything after dropped).
+*/
+std::pair<RedBlackTree::const_iterator, RedBlackTree::const_iterator>
+RedBlackTree::prefixRange(std::string_view prefix) const {
+    std::string limit(prefix);
+    while (!limit.empty() && static_cast<unsigned char>(limit.back()) == 0xFF)
+        limit.pop_back();
+    if (limit.empty())
+        return { lower_bound(prefix), end() };
+    limit.back() = static_cast<char>(static_cast<unsigned char>(limit.back()) + 1);
+    return { lower_bound(prefix), lower_bound(limit) };
+}
+
+/*
+* rank: Lower-bound descent that adds up everything it passes on the left.
+*/
+std::size_t RedBlackTree::rank(std::string_view courseNumber) const {
+    return core.rank(PackedCourseNumber(courseNumber));
+}
+
+/*
+* select: Steers by left-subtree sizes.
+*/
+RedBlackTree::const_iterator RedBlackTree::select(std::size_t k) const {
+    return const_iterator(core.select(k));
+}
+
+/*
+* page: One select for the first course; the end is found by stepping, which is amortized O(1)
+*       per course.
+*/
+std::pair<RedBlackTree::const_iterator, RedBlackTree::const_iterator>
+RedBlackTree::page(std::size_t offset, std::size_t limit) const {
+    const_iterator first = select(offset);
+    const_iterator last = first;
+    for (std::size_t i = 0; i < limit && last != end(); ++i)
+        ++last;
+    return { first, last };
+}
+
+/*
+* searchBatch: Interleaved multi-key search. Groups of probes descend together, each
+*              prefetching the child it will read next round, so one probe's miss is hidden
+*              behind the others' work.
+*/
+void RedBlackTree::searchBatch(const std::string_view* keys, std::size_t count, const Course** results) const {
+    TREE_COUNT(searches, count);
+    core.findBatch(count, [keys](std::size_t i) { return PackedCourseNumber(keys[i]); },
+                   [results](std::size_t i, const CatalogEntry* entry) { results[i] = entry ? &entry->course : nullptr; });
+}
+
+void RedBlackTree::searchBatch(const std::string* keys, std::size_t count, const Course** results) const {
+    TREE_COUNT(searches, count);
+    core.findBatch(count, [keys](std::size_t i) { return PackedCourseNumber(keys[i]); },
+                   [results](std::size_t i, const CatalogEntry* entry) { results[i] = entry ? &entry->course : nullptr; });
+}
+
+void RedBlackTree::searchBatch(const std::vector<std::string>& keys, std::vector<const Course*>& results) const {
+    results.resize(keys.size());
+    searchBatch(keys.data(), keys.size(), results.data());
+}
+
+void RedBlackTree::searchBatch(const std::vector<std::string_view>& keys, std::vector<const Course*>& results) const {
+    results.resize(keys.size());
+    searchBatch(keys.data(), keys.size(), results.data());
+}
+
+/*
+* sortByCourseNumber: Stable sort by course number, skipped for input that is already sorted.
+*                     Large inputs are cut into one run per hardware thread, the runs are
+*                     stable-sorted in parallel, and neighbouring runs are merged pairwise with
+*                     std::inplace_merge (also stable, earlier run first), which yields exactly
+*                     the order std::stable_sort would.
+*/
+static void sortByCourseNumber(std::vector<Course>& courses) {
+    auto byNumber = [](const Course& a, const Course& b) { return a.courseNumber < b.courseNumber; };
+    if (std::is_sorted(courses.begin(), courses.end(), byNumber))
+        return;
+    constexpr std::size_t parallelThreshold = std::size_t(1) << 16;
+    std::size_t runCount = std::thread::hardware_concurrency();
+    if (runCount <= 1 || courses.size() < parallelThreshold) {
+        std::stable_sort(courses.begin(), courses.end(), byNumber);
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+    for (std::size_t r = 0; r <= runCount; ++r)
+        bounds.push_back(courses.size() * r / runCount);
+    auto first = courses.begin();
+    std::vector<std::thread> workers;
+    for (std::size_t r = 0; r < runCount; ++r)
+        workers.emplace_back([&, r]() { std::stable_sort(first + bounds[r], first + bounds[r + 1], byNumber); });
+    for (auto& worker : workers)
+        worker.join();
+
+    while (bounds.size() > 2) {
+        workers.clear();
+        std::vector<std::size_t> merged{ 0 };
+        for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            if (r + 2 < bounds.size()) {
+                std::size_t lo = bounds[r], mid = bounds[r + 1], hi = bounds[r + 2];
+                workers.emplace_back([&, lo, mid, hi]() { std::inplace_merge(first + lo, first + mid, first + hi, byNumber); });
+                merged.push_back(hi);
             }
             else {
-                if (z.get() == zParent->left.get()) {
-                    // Case 2: z is a left child -> convert to Case 3
-                    z = zParent;
-                    rightRotate(z);
-                    zParent = z->parent.lock();
-                    zGrandparent = zParent ? zParent->parent.lock() : nullptr;
-                }
-                // Case 3: z is a right child
-                if (zParent)
-                    zParent->color = BLACK;
-                if (zGrandparent) {
-                    zGrandparent->color = RED;
-                    leftRotate(zGrandparent);
-                }
+                merged.push_back(bounds[r + 1]);  // Odd run out waits for the next round
             }
         }
+        for (auto& worker : workers)
+            worker.join();
+        bounds.swap(merged);
     }
-    if (root)
-        root->color = BLACK;  // Ensure the root is black
+}
+
+// freeze: Copies the courses out in order; the tree is already sorted, so no sort is needed.
+FrozenCatalog RedBlackTree::freeze() const {
+    std::vector<Course> courses;
+    courses.reserve(size());
+    forEachInOrder([&courses](const Course& course) { courses.push_back(course); });
+    return FrozenCatalog(std::move(courses));
 }
 
 /*
-*  insert: Inserts a new course into the Red-Black Tree.
+* bulkLoad: Replaces the tree with the given courses. Sorted input (the normal case for catalog
+*           exports) is detected with one linear pass; anything else is stable-sorted so that
+*           duplicate course numbers keep their file order, exactly as repeated insert() would.
 */
-void RedBlackTree::insert(const Course& course) {
-    auto newNode = std::make_shared<RBTreeNode>(course);
-    // Initialize the new node; its color is set to RED by default.
-    newNode->color = RED;
-    newNode->left = nullptr;
-    newNode->right = nullptr;
-    newNode->parent.reset();
-
-    std::shared_ptr<RBTreeNode> y = nullptr;
-    auto x = root;
-    // Traverse the tree to find the insertion point.
-    while (x) {
-        y = x;
-        if (newNode->course.courseNumber < x->course.courseNumber)
-            x = x->left;
-        else
-            x = x->right;
-    }
-    // Set the parent pointer.
-    if (!y) {
-        root = newNode;  // Tree was empty, new node becomes root.
-    }
-    else if (newNode->course.courseNumber < y->course.courseNumber) {
-        y->left = newNode;
-        newNode->parent = y;  // Assign shared_ptr y to newNode's weak parent.
-    }
-    else {
-        y->right = newNode;
-        newNode->parent = y;
+void RedBlackTree::bulkLoad(std::vector<Course>&& courses, bool knownSorted) {
+    if (!knownSorted)
+        sortByCourseNumber(courses);
+
+    clear();
+    core.assignSorted(std::make_move_iterator(courses.begin()), std::make_move_iterator(courses.end()));
+    if (!observers.empty()) {
+        forEachInOrder([this](const Course& course) {
+            for (CourseObserver* observer : observers)
+                observer->courseAdded(course);
+        });
     }
-    // Restore tree balance and properties.
-    insertFixup(newNode);
 }
 
 /*
-*  searchHelper: Recursively searches for a course node with a specified courese number.
+* readCatalog: Memory-maps the file and tokenizes it in place, so the only allocations are the
+*              strings stored in each Course. Malformed lines are reported after parsing.
 */
-std::shared_ptr<RBTreeNode> RedBlackTree::searchHelper(const std::shared_ptr<RBTreeNode>& node, const std::string& courseNumber) const {
-    if (!node || node->course.courseNumber == courseNumber)
-        return node;
-    if (courseNumber < node->course.courseNumber)
-        return searchHelper(node->left, courseNumber);
-    else
-        return searchHelper(node->right, courseNumber);
+bool RedBlackTree::readCatalog(const std::string& fileName, std::vector<Course>& courses) {
+    MappedFile file;
+    if (!file.open(fileName)) {
+        std::cerr << "Failed to open the file: " << fileName << std::endl;
+        return false;
+    }
+    std::vector<CsvParseError> errors;
+    parseCourseCsvParallel(file.view(), courses, errors);
+    reportParseErrors(errors);
+    return true;
 }
 
 /*
-* search: Public search method that searches for a course by course number and returns it if found.
+* keepLastPerCourse: Gives the records upsert semantics: after a stable sort by number, only
+*                    the last record of each run of equal numbers is kept.
 */
-std::optional<Course> RedBlackTree::search(const std::string& courseNumber) const {
-    auto node = searchHelper(root, courseNumber);
-    if (node)
-        return node->course;
-    return std::nullopt;
+void RedBlackTree::keepLastPerCourse(std::vector<Course>& courses) {
+    sortByCourseNumber(courses);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < courses.size(); ++i) {
+        if (i + 1 < courses.size() && courses[i + 1].courseNumber == courses[i].courseNumber)
+            continue;  // A later record replaces this one
+        if (kept != i)
+            courses[kept] = std::move(courses[i]);
+        ++kept;
+    }
+    courses.resize(kept);
 }
 
 /*
-* loadDataStructure: Loads course data from a CSV file. For each line, it tokenizes the CSV data,
-// creates a Course, and inserts it into the RedBlack Tree.
+* loadDataStructure: Loads course data from a CSV file. An empty tree is bulk-built from the
+*                    records; a tree that already holds courses has each record upserted, so
+*                    loading the same file twice leaves the tree unchanged.
 */
 void RedBlackTree::loadDataStructure(const std::string& fileName) {
-    std::ifstream file(fileName);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open the file: " << fileName << std::endl;
+    std::vector<Course> courses;
+    if (!readCatalog(fileName, courses))
         return;
+
+    if (core.empty()) {
+        keepLastPerCourse(courses);
+        bulkLoad(std::move(courses), true);
+    }
+    else {
+        for (auto& course : courses)
+            upsert(std::move(course));
     }
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty())
-            continue;  // Skip empty lines
-        std::istringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        // Tokenize the line based on commas
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+}
+
+/*
+* reload: Diffs a new version of the catalog against the tree with one merge pass over the
+*         sorted records and the in-order nodes. Changed courses are overwritten in place;
+*         removed and added courses are erased and inserted afterwards, so untouched records
+*         cost one comparison each and no allocation. An empty tree skips the diff and is
+*         bulk-built.
+*/
+ReloadSummary RedBlackTree::reload(const std::string& fileName) {
+    std::vector<Course> courses;
+    if (!readCatalog(fileName, courses))
+        return ReloadSummary();
+    return reload(std::move(courses));
+}
+
+ReloadSummary RedBlackTree::reload(std::vector<Course>&& courses) {
+    ReloadSummary summary;
+    keepLastPerCourse(courses);
+    if (core.empty()) {
+        summary.added = courses.size();
+        bulkLoad(std::move(courses), true);
+        return summary;
+    }
+
+    std::vector<CatalogTree::iterator> removed;
+    std::vector<std::size_t> added;
+    CatalogTree::iterator node = core.begin();
+    std::size_t i = 0;
+    while (node != core.end() || i < courses.size()) {
+        int cmp;
+        if (node == core.end())
+            cmp = 1;
+        else if (i == courses.size())
+            cmp = -1;
+        else
+            cmp = compareCourseKeys(node->key, node->course.courseNumber,
+                                    CourseKey(courses[i].courseNumber), courses[i].courseNumber);
+        if (cmp < 0) {
+            removed.push_back(node++);
         }
-        if (tokens.size() >= 2) {
-            Course newCourse(tokens[0], tokens[1]);
-            // Add any additional tokens as prerequisites
-            for (size_t i = 2; i < tokens.size(); ++i) {
-                newCourse.addPrerequisite(tokens[i]);
-            }
-            insert(newCourse);
+        else if (cmp > 0) {
+            added.push_back(i++);
         }
         else {
-            std::cerr << "Error: Invalid format for course data: " << line << std::endl;
+            if (node->course != courses[i]) {
+                replaceCourse(*node, std::move(courses[i]));
+                ++summary.changed;
+            }
+            else {
+                ++summary.unchanged;
+            }
+            ++i;
+            // Duplicate numbers left over from insert() collapse into the first node.
+            CatalogTree::iterator kept = node++;
+            while (node != core.end() && node->key.packed == kept->key.packed && node->course.courseNumber == kept->course.courseNumber)
+                removed.push_back(node++);
         }
     }
-    file.close();
-}
\ No newline at end of file
+
+    for (CatalogTree::iterator stale : removed)
+        eraseAt(stale);
+    for (std::size_t index : added)
+        insert(std::move(courses[index]));
+    summary.removed = removed.size();
+    summary.added = added.size();
+    return summary;
+}
+
+// Heap bytes owned by a string; short strings live inside the object and own none.
+static std::size_t heapBytes(const std::string& s) {
+    static const std::size_t inlineCapacity = std::string().capacity();
+    return s.capacity() > inlineCapacity ? s.capacity() + 1 : 0;
+}
+
+/*
+* stats: The core measures height and black height; one in-order walk adds up string memory.
+*/
+TreeStats RedBlackTree::stats() const {
+    TreeStats result;
+    result.nodeCount = size();
+    result.height = core.height();
+    result.blackHeight = core.blackHeight();
+
+    std::size_t stringBytes = 0;
+    forEachInOrder([&stringBytes](const Course& course) {
+        stringBytes += heapBytes(course.courseNumber) + heapBytes(course.courseTitle)
+            + course.prerequisites.capacity() * sizeof(std::string);
+        for (const auto& prereq : course.prerequisites)
+            stringBytes += heapBytes(prereq);
+    });
+    result.bytesUsed = size() * sizeof(CatalogTree::Node) + stringBytes;
+    result.bytesReserved = core.bytesReserved() + stringBytes;
+
+#ifdef COURSETREE_INSTRUMENTATION
+    result.instrumented = true;
+    result.counters = metrics.counters();
+    result.insertLatency = metrics.insertLatency.snapshot();
+    result.searchLatency = metrics.searchLatency.snapshot();
+#endif
+    return result;
+}
+
+/*
+* resetCounters: Starts a fresh measurement window for the counters and histograms.
+*/
+void RedBlackTree::resetCounters() {
+#ifdef COURSETREE_INSTRUMENTATION
+    metrics.reset();
+#endif
+}
@@ -13,10 +13,16 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <stdexcept>
 #include <optional>
 #include <filesystem>
+#include <iterator>
+#include <utility>
+#include "BasicRedBlackTree.h"
+#include "CourseKey.h"
+#include "TreeStats.h"
 
 /*
 * Structure: Course
@@ -31,8 +37,9 @@ struct Course {
     // Default constructor
     Course() : courseNumber(""), courseTitle("") {}
 
-    Course(const std::string& number, const std::string& title)
-        : courseNumber(number), courseTitle(title) {
+    // Takes the strings by value so callers passing temporaries (the CSV parser) move them in.
+    Course(std::string number, std::string title)
+        : courseNumber(std::move(number)), courseTitle(std::move(title)) {
     }
 
     // Prints prerequisites.
@@ -46,70 +53,327 @@ struct Course {
     void addPrerequisite(const std::string& prereq) {
         prerequisites.push_back(prereq);
     }
+
+    // Two courses are equal when their number, title and prerequisite list all match.
+    bool operator==(const Course& other) const {
+        return courseNumber == other.courseNumber && courseTitle == other.courseTitle
+            && prerequisites == other.prerequisites;
+    }
+
+    bool operator!=(const Course& other) const { return !(*this == other); }
 };
 
-// Enumeration for node colors in the Red-Black Tree.
-enum Color { RED, BLACK };
+/*
+* Structure: ReloadSummary
+* Description: Counts of what RedBlackTree::reload changed.
+*/
+struct ReloadSummary {
+    std::size_t added = 0;
+    std::size_t changed = 0;
+    std::size_t removed = 0;
+    std::size_t unchanged = 0;
+};
+
+class FrozenCatalog;
+
+/*
+* Class: CourseObserver
+* Description: Told about every change RedBlackTree makes to its stored courses, so secondary
+*              indexes (TitleIndex, ClosureCache) stay in sync without rescanning the tree. A
+*              tree can have several attached; each sees every change. The Course
+*              references point into the tree's nodes; each stays valid until courseRemoved
+*              or cleared reports it gone.
+*/
+class CourseObserver {
+public:
+    virtual ~CourseObserver() = default;
+
+    // A course was stored (inserted, bulk-loaded, or replaced in place).
+    virtual void courseAdded(const Course& course) = 0;
+
+    // A course is about to be erased or overwritten; it is still intact during the call.
+    virtual void courseRemoved(const Course& course) = 0;
+
+    // Every course is about to be dropped at once.
+    virtual void cleared() = 0;
+};
 
 /*
-* Structure: RBTreeNode
-* Description: Represents a node in the Red-Black Tree using smart pointers.
-*              Uses std::shared_ptr for child nodes and std::weak_ptr for the parent.
+* Structure: CatalogEntry
+* Description: What the catalog tree stores per course: the course and its packed number. The
+*              key comes first, right after the node's links, so a descent compares without
+*              reaching the course's strings.
 */
-struct RBTreeNode {
-    Course course;                            
-    Color color;                             
-    std::shared_ptr<RBTreeNode> left;         
-    std::shared_ptr<RBTreeNode> right;        
-    std::weak_ptr<RBTreeNode> parent;         
-
-    // Constructor initializes node with the given course; default color is RED.
-    RBTreeNode(const Course& c)
-        : course(c), color(RED), left(nullptr), right(nullptr), parent() {
+struct CatalogEntry {
+    CourseKey key;            // packed form of course.courseNumber, used for ordering
+    Course course;
+
+    explicit CatalogEntry(const Course& c) : key(c.courseNumber), course(c) {}
+
+    // Takes ownership of the course's strings instead of copying them.
+    explicit CatalogEntry(Course&& c) : key(c.courseNumber), course(std::move(c)) {}
+
+    // Constructs the course itself from Course constructor arguments (RedBlackTree::emplace).
+    template <typename... Args>
+    explicit CatalogEntry(std::in_place_t, Args&&... args) : course(std::forward<Args>(args)...) {
+        key = CourseKey(course.courseNumber);
     }
 };
 
+// The catalog tree's key: an entry's number with the key already packed.
+struct CatalogEntryKey {
+    PackedCourseNumber operator()(const CatalogEntry& entry) const {
+        return PackedCourseNumber(entry.key, entry.course.courseNumber);
+    }
+};
+
+#ifdef COURSETREE_INSTRUMENTATION
+using CatalogTreeEvents = TreeMetricsEvents;
+#else
+using CatalogTreeEvents = NoTreeEvents;
+#endif
+
+// The red-black core behind RedBlackTree: entries ordered by packed course number, with parent
+// links (for iterators and erasing by position) and subtree sizes (for rank and select).
+using CatalogTree = BasicRedBlackTree<PackedCourseNumber, CatalogEntry, CatalogEntryKey, CourseNumberLess,
+                                      std::allocator<CatalogEntry>, NodeLayout<true, true>, CatalogTreeEvents>;
+
 /*
 *
 * Class: RedBlackTree
 * Description: Implements a Red-Black Tree for storing Course objects,
 *              supporting insertion, in-order traversal, searching, and
-*              loading data from a CSV file.
+*              loading data from a CSV file. The balancing and searching are
+*              CatalogTree's (BasicRedBlackTree.h); this class adds the catalog
+*              on top: file loading, upserts, reloads, observers and course
+*              number ranges. Lookups take a string_view, so callers holding a
+*              view or a literal do not build a string.
 */
 class RedBlackTree {
 private:
-    std::shared_ptr<RBTreeNode> root;  // Root of the tree
+    CatalogTree core;             // Owns every node in the tree
+    std::vector<CourseObserver*> observers;  // Secondary indexes kept in sync with the tree
+#ifdef COURSETREE_INSTRUMENTATION
+    mutable TreeMetrics metrics;  // Operation counters and latency histograms (per tree, not moved)
+#endif
 
     // Helper: In‑order traversal that prints node data.
-    void inOrderHelper(const std::shared_ptr<RBTreeNode>& node) const;
+    void inOrderHelper(const CatalogTree::Node* node) const;
+
+    // Tells the observers about a course the core just stored.
+    const Course& added(CatalogEntry& entry);
+
+    // Unlinks the course at pos, telling the observers first.
+    void eraseAt(CatalogTree::iterator pos);
 
-    // Performs left rotation around node x.
-    void leftRotate(std::shared_ptr<RBTreeNode> x);
+    // Overwrites a stored course (same number), telling the observers about the change.
+    void replaceCourse(CatalogEntry& entry, Course&& course);
 
-    // Performs right rotation around node x.
-    void rightRotate(std::shared_ptr<RBTreeNode> x);
+    // Points the core's event hooks at this tree's metrics; a no-op without instrumentation.
+    void attachMetrics();
 
-    // Restores Red–Black properties after insertion.
-    void insertFixup(std::shared_ptr<RBTreeNode> z);
+    // Maps and parses a catalog file, reporting malformed lines. Returns false if it cannot be opened.
+    static bool readCatalog(const std::string& fileName, std::vector<Course>& courses);
 
-    // Recursive helper for searching.
-    std::shared_ptr<RBTreeNode> searchHelper(const std::shared_ptr<RBTreeNode>& node, const std::string& courseNumber) const;
+    // Sorts records by course number (stable) and keeps only the last record for each number.
+    static void keepLastPerCourse(std::vector<Course>& courses);
 
 public:
+    /*
+    * Class: const_iterator
+    * Description: Bidirectional iterator over courses in course-number order. It walks parent
+    *              links, so stepping is amortized O(1). Courses are read-only through it
+    *              because changing a course number would break the ordering. An iterator is
+    *              invalidated when its course is erased or the tree is cleared.
+    */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Course;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Course*;
+        using reference = const Course&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return position->course; }
+        pointer operator->() const { return &position->course; }
+
+        const_iterator& operator++() {
+            ++position;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        // Decrementing end() yields the last course.
+        const_iterator& operator--() {
+            --position;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+
+    private:
+        CatalogTree::const_iterator position;
+
+        explicit const_iterator(CatalogTree::const_iterator position) : position(position) {}
+        friend class RedBlackTree;
+    };
+    using iterator = const_iterator;
+
     RedBlackTree();
-    ~RedBlackTree() = default; // smart pointers handle cleanup
+    ~RedBlackTree() = default; // the arena releases every node at once
+
+    // Nodes are owned by the arena and linked by raw pointers, so the tree moves but never copies.
+    RedBlackTree(const RedBlackTree&) = delete;
+    RedBlackTree& operator=(const RedBlackTree&) = delete;
+    RedBlackTree(RedBlackTree&& other) noexcept;
+    RedBlackTree& operator=(RedBlackTree&& other) noexcept;
 
     // Inserts a course into the tree.
     void insert(const Course& course);
 
-    // Searches for a course by course number. Returns an optional Course.
-    std::optional<Course> search(const std::string& courseNumber) const;
+    // Inserts a course, taking ownership of its strings instead of copying them.
+    void insert(Course&& course);
+
+    // Inserts a course constructed in its node from Course constructor arguments, e.g.
+    // emplace(number, title). Returns the stored course.
+    template <typename... Args>
+    const Course& emplace(Args&&... args) {
+#ifdef COURSETREE_INSTRUMENTATION
+        ScopedLatency scopedLatency(metrics.insertLatency);
+#endif
+        return added(core.emplace(std::in_place, std::forward<Args>(args)...));
+    }
+
+    // Removes the course with the given number. Returns false if it is not in the tree.
+    bool erase(std::string_view courseNumber);
+
+    // Replaces the course with the same number in place, or inserts it if there is none.
+    // Returns true if the course was inserted, false if an existing one was replaced.
+    bool upsert(const Course& course);
+
+    // Same as upsert, moving the course's strings into the tree.
+    bool upsert(Course&& course);
+
+    // The stored course with this number, or null; nothing is copied. The pointer is a view
+    // into the tree's node: it stays valid until that course is erased, the tree is cleared,
+    // reloaded or bulk-loaded, or the tree is destroyed. An upsert of the same number replaces
+    // the course in place, so the pointer then sees the new record. Moving the tree keeps it
+    // valid (the nodes move with it). Do not hold it across changes made by another thread.
+    // With duplicate numbers (from insert), it is the first one stored.
+    const Course* find(std::string_view courseNumber) const;
+
+    // Searches for a course by course number and returns a copy, which stays valid whatever
+    // happens to the tree later. Prefer find when the course is only read straight away.
+    std::optional<Course> search(std::string_view courseNumber) const;
+
+    // Looks up count course numbers at once, writing a pointer to each stored course (or null)
+    // into results[i]. Groups of keys descend the tree in lockstep with software prefetching,
+    // so their cache misses overlap. Pointers stay valid until the course is erased or the
+    // tree is cleared.
+    void searchBatch(const std::string* keys, std::size_t count, const Course** results) const;
+    void searchBatch(const std::string_view* keys, std::size_t count, const Course** results) const;
+
+    // Convenience overloads; resize results to keys.size().
+    void searchBatch(const std::vector<std::string>& keys, std::vector<const Course*>& results) const;
+    void searchBatch(const std::vector<std::string_view>& keys, std::vector<const Course*>& results) const;
+
+    // Iterators over all courses in course-number order.
+    const_iterator begin() const { return const_iterator(core.begin()); }
+    const_iterator end() const { return const_iterator(core.end()); }
+
+    // First course whose number is not less than courseNumber.
+    const_iterator lower_bound(std::string_view courseNumber) const;
+
+    // First course whose number is greater than courseNumber.
+    const_iterator upper_bound(std::string_view courseNumber) const;
+
+    // All courses with exactly this number, as [lower_bound, upper_bound).
+    std::pair<const_iterator, const_iterator> equal_range(std::string_view courseNumber) const;
+
+    // All courses whose number starts with prefix (e.g. "CSCI"), in O(log n + k).
+    std::pair<const_iterator, const_iterator> prefixRange(std::string_view prefix) const;
+
+    // Number of courses whose number is less than courseNumber: its zero-based position in
+    // course-number order if stored, or the position it would take. O(log n).
+    std::size_t rank(std::string_view courseNumber) const;
+
+    // The course at zero-based position k in course-number order, or end() if k >= size().
+    // O(log n).
+    const_iterator select(std::size_t k) const;
+
+    // Up to limit courses starting at position offset, for listing the catalog a page at a
+    // time without walking the courses before it. O(log n + limit).
+    std::pair<const_iterator, const_iterator> page(std::size_t offset, std::size_t limit) const;
 
     // Performs an in‑order traversal of the tree.
     void inOrder() const;
 
-    // Loads course data from a CSV file.
+    // Calls visit(const Course&) for every course in course-number order, without printing.
+    template <typename Visitor>
+    void forEachInOrder(Visitor&& visit) const {
+        core.forEach([&visit](const CatalogEntry& entry) { visit(entry.course); });
+    }
+
+    // Compiles a read-only copy of the current courses for the serving phase. The copy is
+    // independent of the tree, so later changes to the tree are not reflected in it.
+    FrozenCatalog freeze() const;
+
+    // Replaces the tree's contents with the given courses in O(n) without rotations.
+    // Input that is not already sorted by course number is stable-sorted first.
+    void bulkLoad(std::vector<Course>&& courses, bool knownSorted = false);
+
+    // Loads course data from a CSV file. Records are upserted: each course number is
+    // stored once, and the last record for a number wins.
     void loadDataStructure(const std::string& fileName);
+
+    // Brings the tree in line with a new version of the CSV file, touching only the
+    // records that were added, changed or removed.
+    ReloadSummary reload(const std::string& fileName);
+
+    // Same as reload, with the records already parsed (in file order; the last record for a
+    // number wins). An empty tree is bulk-built from them.
+    ReloadSummary reload(std::vector<Course>&& courses);
+
+    // Removes every course and frees all nodes in one shot.
+    void clear();
+
+    // Number of courses stored in the tree.
+    std::size_t size() const { return core.size(); }
+
+    // Height, black height, node count and memory, plus the operation counters and latency
+    // histograms when built with COURSETREE_INSTRUMENTATION. Walks the whole tree: O(n).
+    TreeStats stats() const;
+
+    // Null if the red-black rules, key order, parent links and subtree sizes all hold;
+    // otherwise a description of the first broken one. Walks the whole tree: O(n).
+    const char* checkInvariants() const { return core.checkInvariants(); }
+
+    // Zeroes the operation counters and histograms; a no-op without instrumentation.
+    void resetCounters();
+
+    // Attaches an observer alongside any already attached; attaching one twice does nothing.
+    // The new observer is cleared and then told about every course already stored, so it can
+    // be attached before or after loading. Observers move with the tree's nodes and must
+    // outlive their attachment.
+    void addObserver(CourseObserver* observer);
+
+    // Detaches an observer without telling it anything; it keeps what it has seen so far.
+    // Does nothing if it is not attached.
+    void removeObserver(CourseObserver* observer);
 };
 
 
@@ -0,0 +1,81 @@
+/*
+    File: CourseKey.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: CourseKey
+    Description: Packed 64-bit course number prefix used for fast tree comparisons
+*/
+#ifndef COURSE_KEY_H
+#define COURSE_KEY_H
+
+#include <cstdint>
+#include <string_view>
+
+/*
+* Structure: CourseKey
+* Description: Packs the first eight characters of a course number into one big-endian
+*              64-bit integer (zero padded), so comparing two packed values gives the same
+*              answer as comparing the strings. Every regular DEPT#### number fits entirely;
+*              longer, irregular numbers set overflow and fall back to a full string compare
+*              only when their first eight characters tie.
+*/
+struct CourseKey {
+    std::uint64_t packed;   // first eight characters, most significant byte first
+    bool overflow;          // true when the course number is longer than eight characters
+
+    CourseKey() : packed(0), overflow(false) {}
+
+    explicit CourseKey(std::string_view number) : packed(0), overflow(number.size() > 8) {
+        std::size_t count = number.size() < 8 ? number.size() : 8;
+        for (std::size_t i = 0; i < count; ++i)
+            packed |= std::uint64_t(static_cast<unsigned char>(number[i])) << (56 - 8 * i);
+    }
+};
+
+// Three-way comparison of two course numbers using their packed keys. Returns <0, 0 or >0
+// exactly as aNumber.compare(bNumber) would (course numbers never contain NUL characters).
+inline int compareCourseKeys(const CourseKey& a, std::string_view aNumber,
+                             const CourseKey& b, std::string_view bNumber) {
+    if (a.packed != b.packed)
+        return a.packed < b.packed ? -1 : 1;
+    if (!a.overflow && !b.overflow)
+        return 0;
+    return aNumber.compare(bNumber);
+}
+
+/*
+* Structure: PackedCourseNumber
+* Description: A course number together with its packed key, so a lookup packs its argument once
+*              and every comparison on the way down reuses it. The viewed characters must outlive it.
+*/
+struct PackedCourseNumber {
+    CourseKey key;
+    std::string_view number;
+
+    PackedCourseNumber() = default;
+    explicit PackedCourseNumber(std::string_view number) : key(number), number(number) {}
+    PackedCourseNumber(const CourseKey& key, std::string_view number) : key(key), number(number) {}
+};
+
+/*
+* Structure: CourseNumberLess
+* Description: Course-number order over packed numbers, for BasicRedBlackTree. It is transparent,
+*              so plain strings and string_views can be looked up too (packed per comparison).
+*/
+struct CourseNumberLess {
+    using is_transparent = void;
+
+    bool operator()(const PackedCourseNumber& a, const PackedCourseNumber& b) const {
+        return compareCourseKeys(a.key, a.number, b.key, b.number) < 0;
+    }
+
+    bool operator()(const PackedCourseNumber& a, std::string_view b) const {
+        return (*this)(a, PackedCourseNumber(b));
+    }
+
+    bool operator()(std::string_view a, const PackedCourseNumber& b) const {
+        return (*this)(PackedCourseNumber(a), b);
+    }
+};
+
+#endif
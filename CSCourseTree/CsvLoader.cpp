@@ -0,0 +1,250 @@
+/*
+    File: CsvLoader.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Memory-mapped file access and in-place CSV tokenizing for the course catalog
+*/
+
+#include "CsvLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile()
+    : data(nullptr), length(0), opened(false), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+}
+#else
+MappedFile::MappedFile() : data(nullptr), length(0), opened(false) {}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/*
+* open: Maps the whole file read-only. Empty files succeed with an empty view.
+*/
+bool MappedFile::open(const std::string& fileName) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    opened = true;
+    if (size.QuadPart == 0)
+        return true;
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        close();
+        return false;
+    }
+    length = static_cast<std::size_t>(size.QuadPart);
+    return true;
+#else
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    opened = true;
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        opened = false;
+        return false;
+    }
+    madvise(mapping, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapping);
+    length = static_cast<std::size_t>(info.st_size);
+    return true;
+#endif
+}
+
+/*
+* close: Releases the mapping and any handles.
+*/
+void MappedFile::close() {
+#ifdef _WIN32
+    if (data)
+        UnmapViewOfFile(data);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (data)
+        munmap(const_cast<char*>(data), length);
+#endif
+    data = nullptr;
+    length = 0;
+    opened = false;
+}
+
+/*
+* splitCsvLine: Tokenizes a line on commas into views over the original buffer.
+*/
+void splitCsvLine(std::string_view line, std::vector<std::string_view>& fields) {
+    fields.clear();
+    std::size_t start = 0;
+    while (start < line.size()) {
+        std::size_t comma = line.find(',', start);
+        if (comma == std::string_view::npos) {
+            fields.push_back(line.substr(start));
+            return;
+        }
+        fields.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+/*
+* parseCourseCsv: Walks the buffer line by line without copying it. Lines may end in "\n" or
+*                 "\r\n"; blank lines are skipped. Lines with fewer than two fields are
+*                 recorded as errors with their line number.
+*/
+std::size_t parseCourseCsv(std::string_view data, std::vector<Course>& out,
+                           std::vector<CsvParseError>& errors, std::size_t firstLine) {
+    std::vector<std::string_view> fields;  // Reused across lines, so it stops allocating quickly
+    std::size_t lineNumber = firstLine;
+    const char* cursor = data.data();
+    const char* end = cursor + data.size();
+    for (; cursor < end; ++lineNumber) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        const char* lineEnd = newline ? newline : end;
+        std::string_view line(cursor, static_cast<std::size_t>(lineEnd - cursor));
+        cursor = newline ? newline + 1 : end;
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;  // Skip empty lines
+
+        splitCsvLine(line, fields);
+        if (fields.size() < 2) {
+            errors.push_back({ lineNumber, std::string(line) });
+            continue;
+        }
+        out.emplace_back(std::string(fields[0]), std::string(fields[1]));
+        Course& course = out.back();
+        course.prerequisites.reserve(fields.size() - 2);
+        for (std::size_t i = 2; i < fields.size(); ++i)
+            course.prerequisites.emplace_back(fields[i]);
+    }
+    return lineNumber - firstLine;
+}
+
+/*
+* parseCourseCsvParallel: Cuts the buffer into a few chunks per worker, each ending just after
+*                         a newline, so no line straddles two chunks. Workers claim chunks
+*                         from a shared counter and parse them with line numbers relative to
+*                         the chunk; the chunks are then concatenated in file order and error
+*                         line numbers shifted by the line counts of the chunks before them.
+*/
+void parseCourseCsvParallel(std::string_view data, std::vector<Course>& out,
+                            std::vector<CsvParseError>& errors, unsigned threads) {
+    constexpr std::size_t minChunkBytes = std::size_t(1) << 20;
+    unsigned threadCount = threads ? threads : std::thread::hardware_concurrency();
+    if (threadCount <= 1 || data.size() < 2 * minChunkBytes) {
+        parseCourseCsv(data, out, errors);
+        return;
+    }
+
+    std::size_t chunkTarget = std::min<std::size_t>(std::size_t(threadCount) * 4, data.size() / minChunkBytes);
+    std::vector<std::size_t> starts{ 0 };
+    for (std::size_t c = 1; c < chunkTarget; ++c) {
+        std::size_t pos = std::max(starts.back(), c * (data.size() / chunkTarget));
+        const void* newline = std::memchr(data.data() + pos, '\n', data.size() - pos);
+        if (!newline)
+            break;
+        std::size_t next = static_cast<std::size_t>(static_cast<const char*>(newline) - data.data()) + 1;
+        if (next >= data.size())
+            break;
+        if (next > starts.back())
+            starts.push_back(next);
+    }
+    starts.push_back(data.size());
+
+    struct Chunk {
+        std::vector<Course> courses;
+        std::vector<CsvParseError> errors;
+        std::size_t lines = 0;
+    };
+    std::vector<Chunk> chunks(starts.size() - 1);
+    std::atomic<std::size_t> nextChunk{ 0 };
+    auto work = [&]() {
+        for (std::size_t i; (i = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks.size();) {
+            std::string_view chunk = data.substr(starts[i], starts[i + 1] - starts[i]);
+            chunks[i].lines = parseCourseCsv(chunk, chunks[i].courses, chunks[i].errors);
+        }
+    };
+    std::vector<std::thread> workers;
+    unsigned workerCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, chunks.size()));
+    for (unsigned t = 1; t < workerCount; ++t)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+
+    std::size_t total = 0;
+    for (const auto& chunk : chunks)
+        total += chunk.courses.size();
+    out.reserve(out.size() + total);
+    std::size_t linesBefore = 0;
+    for (auto& chunk : chunks) {
+        for (auto& error : chunk.errors) {
+            error.lineNumber += linesBefore;
+            errors.push_back(std::move(error));
+        }
+        std::move(chunk.courses.begin(), chunk.courses.end(), std::back_inserter(out));
+        linesBefore += chunk.lines;
+    }
+}
+
+/*
+* reportParseErrors: Writes malformed lines to std::cerr, one per line, with their line numbers.
+*/
+void reportParseErrors(const std::vector<CsvParseError>& errors) {
+    for (const auto& error : errors)
+        std::cerr << "Error: Invalid format for course data on line " << error.lineNumber
+                  << ": " << error.line << std::endl;
+}
@@ -0,0 +1,79 @@
+/*
+    File: CsvLoader.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: MappedFile, CsvParseError
+    Description: Memory-mapped, zero-copy tokenizer for the course catalog CSV format
+*/
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+
+/*
+* Class: MappedFile
+* Description: Read-only memory mapping of a whole file. The contents are exposed as a
+*              string_view that stays valid until the MappedFile is closed or destroyed.
+*/
+class MappedFile {
+private:
+    const char* data;
+    std::size_t length;
+    bool opened;        // Zero-length files have no mapping but still open successfully
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the named file. Returns false (leaving the object closed) if it cannot be mapped.
+    bool open(const std::string& fileName);
+
+    // Unmaps the file; safe to call on a closed object.
+    void close();
+
+    bool isOpen() const { return opened; }
+
+    // Entire file contents.
+    std::string_view view() const { return std::string_view(data, length); }
+};
+
+/*
+* Structure: CsvParseError
+* Description: A malformed catalog line and its 1-based line number in the source file.
+*/
+struct CsvParseError {
+    std::size_t lineNumber;
+    std::string line;
+};
+
+// Splits one line (without its newline) into comma-separated fields. Follows std::getline
+// semantics: empty fields are kept, but a trailing comma does not produce an empty last field.
+void splitCsvLine(std::string_view line, std::vector<std::string_view>& fields);
+
+// Parses every record in data, appending courses to out and malformed lines to errors.
+// Line numbers start at firstLine. Only the strings stored in each Course are allocated.
+// Returns the number of lines scanned, blank ones included.
+std::size_t parseCourseCsv(std::string_view data, std::vector<Course>& out,
+                           std::vector<CsvParseError>& errors, std::size_t firstLine = 1);
+
+// Same result as parseCourseCsv (courses and errors in file order, same line numbers), but
+// the buffer is split on line boundaries into chunks that are parsed on up to threads
+// workers (0 = one per hardware thread). Small inputs are parsed on the calling thread.
+void parseCourseCsvParallel(std::string_view data, std::vector<Course>& out,
+                            std::vector<CsvParseError>& errors, unsigned threads = 0);
+
+// Prints each error to std::cerr in the order given.
+void reportParseErrors(const std::vector<CsvParseError>& errors);
+
+#endif
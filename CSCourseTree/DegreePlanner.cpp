@@ -0,0 +1,234 @@
+/*
+    File: DegreePlanner.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Parallel Kahn-style degree plan scheduling and cycle reporting
+*/
+
+#include "DegreePlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+    constexpr std::uint32_t unscheduledLevel = UINT32_MAX;
+}
+
+/*
+* plan: Whole-catalog schedule.
+*/
+DegreePlan DegreePlanner::plan(const PlanOptions& options) const {
+    return schedule(std::vector<unsigned char>(graph.size(), 1), options);
+}
+
+/*
+* plan: Schedule restricted to the targets plus their full prerequisite closure.
+*/
+DegreePlan DegreePlanner::plan(const std::vector<std::uint32_t>& targets, const PlanOptions& options) const {
+    std::vector<unsigned char> included(graph.size(), 0);
+    std::vector<std::uint32_t> work;
+    for (std::uint32_t target : targets) {
+        if (target < graph.size() && !included[target]) {
+            included[target] = 1;
+            work.push_back(target);
+        }
+    }
+    while (!work.empty()) {
+        std::uint32_t current = work.back();
+        work.pop_back();
+        for (std::uint32_t prereq : graph.prerequisitesOf(current)) {
+            if (!included[prereq]) {
+                included[prereq] = 1;
+                work.push_back(prereq);
+            }
+        }
+    }
+    return schedule(included, options);
+}
+
+/*
+* schedule: Level-synchronous Kahn's algorithm. Each round expands the current frontier (the
+*           courses whose prerequisites are all placed) by decrementing the in-degree of their
+*           dependents; a dependent whose counter reaches zero joins the next frontier. Large
+*           frontiers are split into contiguous chunks, one per worker thread, and exactly one
+*           thread observes each counter's transition to zero, so no locking is needed.
+*/
+DegreePlan DegreePlanner::schedule(const std::vector<unsigned char>& included, const PlanOptions& options) const {
+    const std::size_t n = graph.size();
+    unsigned threadCount = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    std::unique_ptr<std::atomic<std::uint32_t>[]> indegree(new std::atomic<std::uint32_t>[n]);
+    std::vector<std::uint32_t> level(n, unscheduledLevel);
+    std::vector<std::uint32_t> frontier;
+    for (std::uint32_t id = 0; id < n; ++id) {
+        std::uint32_t count = included[id] ? static_cast<std::uint32_t>(graph.prerequisitesOf(id).size()) : 0;
+        indegree[id].store(count, std::memory_order_relaxed);
+        if (included[id] && count == 0)
+            frontier.push_back(id);
+    }
+
+    auto expand = [&](std::size_t begin, std::size_t end, std::vector<std::uint32_t>& out) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::uint32_t dependent : graph.dependentsOf(frontier[i])) {
+                if (included[dependent] && indegree[dependent].fetch_sub(1, std::memory_order_relaxed) == 1)
+                    out.push_back(dependent);
+            }
+        }
+    };
+
+    DegreePlan result;
+    std::vector<std::uint32_t> next;
+    std::vector<std::vector<std::uint32_t>> partial(threadCount);
+    for (std::uint32_t term = 0; !frontier.empty(); ++term) {
+        std::sort(frontier.begin(), frontier.end());  // Deterministic output regardless of thread timing
+        for (std::uint32_t id : frontier)
+            level[id] = term;
+        result.courses.insert(result.courses.end(), frontier.begin(), frontier.end());
+        result.termOffsets.push_back(result.courses.size());
+
+        next.clear();
+        if (threadCount == 1 || frontier.size() < options.parallelThreshold) {
+            expand(0, frontier.size(), next);
+        }
+        else {
+            std::size_t chunk = (frontier.size() + threadCount - 1) / threadCount;
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < threadCount; ++t) {
+                std::size_t begin = std::min(frontier.size(), t * chunk);
+                std::size_t end = std::min(frontier.size(), begin + chunk);
+                partial[t].clear();
+                workers.emplace_back(expand, begin, end, std::ref(partial[t]));
+            }
+            expand(0, std::min(frontier.size(), chunk), next);
+            for (auto& worker : workers)
+                worker.join();
+            for (unsigned t = 1; t < threadCount; ++t)
+                next.insert(next.end(), partial[t].begin(), partial[t].end());
+        }
+        frontier.swap(next);
+    }
+
+    std::vector<unsigned char> unscheduled(n, 0);
+    bool anyUnscheduled = false;
+    for (std::uint32_t id = 0; id < n; ++id) {
+        if (included[id] && level[id] == unscheduledLevel) {
+            unscheduled[id] = 1;
+            anyUnscheduled = true;
+        }
+    }
+    if (anyUnscheduled)
+        findCycles(unscheduled, result);
+
+    if (options.maxCoursesPerTerm == 0)
+        return result;
+
+    // Capacity-limited list scheduling: every term takes the available courses with the
+    // earliest unconstrained term first; whatever does not fit waits for the next term.
+    DegreePlan capped;
+    capped.cycles = std::move(result.cycles);
+    capped.blocked = std::move(result.blocked);
+    std::vector<std::uint32_t> remaining(n, 0);
+    using Entry = std::pair<std::uint32_t, std::uint32_t>;  // (earliest term, course ID)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> available;
+    for (std::uint32_t id = 0; id < n; ++id) {
+        if (!included[id])
+            continue;
+        remaining[id] = static_cast<std::uint32_t>(graph.prerequisitesOf(id).size());
+        if (remaining[id] == 0)
+            available.emplace(level[id], id);
+    }
+    std::vector<std::uint32_t> termCourses;
+    while (!available.empty()) {
+        termCourses.clear();
+        while (!available.empty() && termCourses.size() < options.maxCoursesPerTerm) {
+            termCourses.push_back(available.top().second);
+            available.pop();
+        }
+        std::sort(termCourses.begin(), termCourses.end());
+        capped.courses.insert(capped.courses.end(), termCourses.begin(), termCourses.end());
+        capped.termOffsets.push_back(capped.courses.size());
+        // Newly unlocked courses become available only from the following term on.
+        for (std::uint32_t id : termCourses) {
+            for (std::uint32_t dependent : graph.dependentsOf(id)) {
+                if (included[dependent] && --remaining[dependent] == 0)
+                    available.emplace(level[dependent], dependent);
+            }
+        }
+    }
+    return capped;
+}
+
+/*
+* findCycles: Iterative Tarjan strongly-connected-components pass over the prerequisite edges
+*             of the unscheduled courses. Every component with more than one course (or a
+*             course that lists itself) is a cycle; the rest are only blocked by one.
+*/
+void DegreePlanner::findCycles(const std::vector<unsigned char>& unscheduled, DegreePlan& plan) const {
+    const std::size_t n = graph.size();
+    constexpr std::uint32_t unvisited = UINT32_MAX;
+    std::vector<std::uint32_t> index(n, unvisited);
+    std::vector<std::uint32_t> low(n, 0);
+    std::vector<unsigned char> onStack(n, 0);
+    std::vector<std::uint32_t> stack;
+    std::vector<std::pair<std::uint32_t, std::size_t>> calls;  // (course, next edge to visit)
+    std::uint32_t counter = 0;
+
+    auto visit = [&](std::uint32_t id) {
+        index[id] = low[id] = counter++;
+        stack.push_back(id);
+        onStack[id] = 1;
+        calls.emplace_back(id, 0);
+    };
+
+    for (std::uint32_t start = 0; start < n; ++start) {
+        if (!unscheduled[start] || index[start] != unvisited)
+            continue;
+        visit(start);
+        while (!calls.empty()) {
+            std::uint32_t current = calls.back().first;
+            PrerequisiteGraph::IdRange edges = graph.prerequisitesOf(current);
+            if (calls.back().second < edges.size()) {
+                std::uint32_t prereq = edges.first[calls.back().second++];
+                if (!unscheduled[prereq])
+                    continue;
+                if (index[prereq] == unvisited)
+                    visit(prereq);
+                else if (onStack[prereq])
+                    low[current] = std::min(low[current], index[prereq]);
+                continue;
+            }
+            calls.pop_back();
+            if (!calls.empty())
+                low[calls.back().first] = std::min(low[calls.back().first], low[current]);
+            if (low[current] != index[current])
+                continue;
+
+            std::vector<std::uint32_t> component;
+            std::uint32_t member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack[member] = 0;
+                component.push_back(member);
+            } while (member != current);
+
+            bool selfLoop = false;
+            for (std::uint32_t prereq : edges)
+                selfLoop = selfLoop || prereq == current;
+            if (component.size() > 1 || selfLoop) {
+                std::sort(component.begin(), component.end());
+                plan.cycles.push_back(std::move(component));
+            }
+            else {
+                plan.blocked.push_back(current);
+            }
+        }
+    }
+    std::sort(plan.blocked.begin(), plan.blocked.end());
+}
@@ -0,0 +1,75 @@
+/*
+    File: DegreePlanner.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: DegreePlanner, DegreePlan, PlanOptions
+    Description: Multi-threaded topological term scheduler over the prerequisite graph
+*/
+#ifndef DEGREE_PLANNER_H
+#define DEGREE_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PrerequisiteGraph.h"
+
+/*
+* Structure: PlanOptions
+* Description: Tuning knobs for DegreePlanner::plan.
+*/
+struct PlanOptions {
+    std::size_t maxCoursesPerTerm = 0;    // 0 means no per-term capacity
+    unsigned threads = 0;                 // 0 means std::thread::hardware_concurrency()
+    std::size_t parallelThreshold = 4096; // frontiers smaller than this are expanded inline
+};
+
+/*
+* Structure: DegreePlan
+* Description: Term-by-term course ordering. Terms are stored CSR-style: term t holds
+*              courses[termOffsets[t] .. termOffsets[t + 1]), sorted by course ID.
+*              Courses caught in prerequisite cycles are never scheduled; each cycle is
+*              listed in cycles, and courses that only depend on a cycle are in blocked.
+*/
+struct DegreePlan {
+    std::vector<std::uint32_t> courses;
+    std::vector<std::size_t> termOffsets{ 0 };
+    std::vector<std::vector<std::uint32_t>> cycles;
+    std::vector<std::uint32_t> blocked;
+
+    std::size_t termCount() const { return termOffsets.size() - 1; }
+
+    PrerequisiteGraph::IdRange term(std::size_t t) const {
+        return { courses.data() + termOffsets[t], courses.data() + termOffsets[t + 1] };
+    }
+
+    bool hasCycle() const { return !cycles.empty(); }
+};
+
+/*
+* Class: DegreePlanner
+* Description: Computes topological levels of the prerequisite DAG with a Kahn-style
+*              frontier expansion. Large frontiers are split across worker threads that
+*              decrement shared atomic in-degree counters; each course lands in the first
+*              term after all of its prerequisites. With a capacity, terms are then filled
+*              greedily in (earliest term, course ID) order.
+*/
+class DegreePlanner {
+public:
+    explicit DegreePlanner(const PrerequisiteGraph& graph) : graph(graph) {}
+
+    // Schedules every course in the catalog.
+    DegreePlan plan(const PlanOptions& options = PlanOptions()) const;
+
+    // Schedules only the target courses and everything they transitively require.
+    DegreePlan plan(const std::vector<std::uint32_t>& targets, const PlanOptions& options = PlanOptions()) const;
+
+private:
+    const PrerequisiteGraph& graph;
+
+    DegreePlan schedule(const std::vector<unsigned char>& included, const PlanOptions& options) const;
+
+    // Finds the prerequisite cycles among courses Kahn's algorithm could not schedule.
+    void findCycles(const std::vector<unsigned char>& unscheduled, DegreePlan& plan) const;
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*
+    File: EligibilityEngine.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: EligibilityEngine
+    Description: Prerequisite bitset construction and the single-student and bit-sliced batch
+                 eligibility kernels
+*/
+
+#include "EligibilityEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    // Index of the lowest set bit of a non-zero word.
+    inline unsigned lowestBit(std::uint64_t word) {
+#if defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+            return static_cast<unsigned>(index);
+        _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+        return static_cast<unsigned>(index) + 32;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+    }
+
+    // Appends the position of every set bit, offset by base, in increasing order.
+    inline void appendBits(std::uint64_t word, std::uint32_t base, std::vector<std::uint32_t>& out) {
+        for (; word; word &= word - 1)
+            out.push_back(base + lowestBit(word));
+    }
+
+    // Transposes a 64x64 bit matrix in place (bit c of a[r] swaps with bit r of a[c]) in six
+    // rounds of block swaps, halving the block size each round.
+    void transpose64(std::uint64_t a[64]) {
+        std::uint64_t mask = 0x00000000FFFFFFFFull;
+        for (unsigned j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+            for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                std::uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+                a[k] ^= t << j;
+                a[k | j] ^= t;
+            }
+        }
+    }
+}
+
+std::vector<std::uint32_t> EligibilityBatch::courses(std::size_t s) const {
+    std::vector<std::uint32_t> ids;
+    const std::uint64_t* set = student(s);
+    for (std::size_t w = 0; w < wordsPerStudent; ++w)
+        appendBits(set[w], static_cast<std::uint32_t>(w * 64), ids);
+    return ids;
+}
+
+/*
+* EligibilityEngine: Sorts and de-duplicates each course's prerequisites, keeps them as IDs for
+*                    the batch kernel and folds them into (word, mask) terms for the single one.
+*/
+EligibilityEngine::EligibilityEngine(const PrerequisiteGraph& graph)
+    : graph(graph), courseCount(graph.size()), wordCount((graph.size() + 63) / 64) {
+    prereqOffsets.reserve(courseCount + 1);
+    prereqOffsets.push_back(0);
+    std::vector<std::uint32_t> prereqs;
+    for (std::uint32_t id = 0; id < courseCount; ++id) {
+        auto range = graph.prerequisitesOf(id);
+        prereqs.assign(range.begin(), range.end());
+        std::sort(prereqs.begin(), prereqs.end());
+        prereqs.erase(std::unique(prereqs.begin(), prereqs.end()), prereqs.end());
+        std::size_t firstTerm = termWords.size();
+        for (std::uint32_t prereq : prereqs) {
+            prereqIds.push_back(prereq);
+            std::uint32_t word = prereq / 64;
+            if (termWords.size() == firstTerm || termWords.back() != word) {
+                termCourses.push_back(id);
+                termWords.push_back(word);
+                termMasks.push_back(0);
+            }
+            termMasks.back() |= std::uint64_t(1) << (prereq % 64);
+        }
+        prereqOffsets.push_back(static_cast<std::uint32_t>(prereqIds.size()));
+    }
+}
+
+EligibilityEngine::Bitset EligibilityEngine::completedSet(const std::vector<std::uint32_t>& completedIds) const {
+    Bitset completed(wordCount, 0);
+    for (std::uint32_t id : completedIds) {
+        if (id < courseCount)
+            completed[id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+    return completed;
+}
+
+EligibilityEngine::Bitset EligibilityEngine::completedSet(const std::vector<std::string>& completedNumbers) const {
+    std::vector<std::uint32_t> ids;
+    ids.reserve(completedNumbers.size());
+    for (const auto& number : completedNumbers)
+        ids.push_back(graph.idOf(number));  // npos is out of range and dropped
+    return completedSet(ids);
+}
+
+/*
+* eligibleSet: Starts from every course and makes one flat pass over all the terms; each term
+*              check is an AND and a compare that clears its course's bit on failure, with no
+*              branches. Completed courses are then masked out a word at a time.
+*/
+EligibilityEngine::Bitset EligibilityEngine::eligibleSet(const Bitset& completed) const {
+    if (completed.size() < wordCount) {
+        Bitset padded(completed);
+        padded.resize(wordCount, 0);
+        return eligibleSet(padded);
+    }
+    Bitset result(wordCount, ~std::uint64_t(0));
+    const std::uint64_t* have = completed.data();
+    std::uint64_t* out = result.data();
+    const std::size_t termCount = termWords.size();
+    for (std::size_t t = 0; t < termCount; ++t) {
+        std::uint64_t unmet = (have[termWords[t]] & termMasks[t]) != termMasks[t];
+        out[termCourses[t] / 64] &= ~(unmet << (termCourses[t] % 64));
+    }
+    for (std::size_t w = 0; w < wordCount; ++w)
+        out[w] &= ~have[w];
+    if (courseCount % 64)
+        out[wordCount - 1] &= (std::uint64_t(1) << (courseCount % 64)) - 1;
+    return result;
+}
+
+std::vector<std::uint32_t> EligibilityEngine::eligible(const Bitset& completed) const {
+    Bitset set = eligibleSet(completed);
+    std::vector<std::uint32_t> ids;
+    for (std::size_t w = 0; w < set.size(); ++w)
+        appendBits(set[w], static_cast<std::uint32_t>(w * 64), ids);
+    return ids;
+}
+
+/*
+* evaluateBlock: Scatters the block's completed sets into one 256-bit row per course (bit s of
+*                a row: student first + s completed that course), then walks every course once,
+*                ANDing its prerequisites' rows. Each finished group of 64 courses is a 64x64
+*                bit matrix per lane; transposed, its rows are the students' words for that
+*                group. Only the rows the block set are cleared afterwards, so the scratch rows
+*                are never rescanned.
+*/
+void EligibilityEngine::evaluateBlock(const std::vector<std::vector<std::uint32_t>>& students, std::size_t first,
+                                      std::size_t last, std::vector<std::uint64_t>& rows,
+                                      EligibilityBatch& batch) const {
+    std::uint64_t present[laneWords] = {};
+    for (std::size_t s = first; s < last; ++s) {
+        std::size_t lane = (s - first) / 64;
+        std::uint64_t bit = std::uint64_t(1) << ((s - first) % 64);
+        present[lane] |= bit;
+        for (std::uint32_t id : students[s]) {
+            if (id < courseCount)
+                rows[id * laneWords + lane] |= bit;
+        }
+    }
+
+    const std::uint64_t* row = rows.data();
+    std::uint64_t met[laneWords][64];       // lane -> course within the group -> students
+    for (std::size_t group = 0; group < wordCount; ++group) {
+        std::size_t base = group * 64;
+        std::size_t count = std::min<std::size_t>(64, courseCount - base);
+        for (std::size_t c = 0; c < 64; ++c) {
+            std::uint64_t lanes[laneWords] = {};
+            if (c < count) {
+                std::size_t id = base + c;
+                for (std::size_t l = 0; l < laneWords; ++l)
+                    lanes[l] = present[l] & ~row[id * laneWords + l];
+                for (std::uint32_t p = prereqOffsets[id]; p < prereqOffsets[id + 1]; ++p) {
+                    const std::uint64_t* prereqRow = row + std::size_t(prereqIds[p]) * laneWords;
+                    for (std::size_t l = 0; l < laneWords; ++l)
+                        lanes[l] &= prereqRow[l];
+                }
+            }
+            for (std::size_t l = 0; l < laneWords; ++l)
+                met[l][c] = lanes[l];
+        }
+        for (std::size_t l = 0; l < laneWords && first + l * 64 < last; ++l) {
+            transpose64(met[l]);
+            std::size_t studentsInLane = std::min<std::size_t>(64, last - (first + l * 64));
+            for (std::size_t s = 0; s < studentsInLane; ++s)
+                batch.words[(first + l * 64 + s) * wordCount + group] = met[l][s];
+        }
+    }
+
+    for (std::size_t s = first; s < last; ++s) {
+        for (std::uint32_t id : students[s]) {
+            if (id < courseCount)
+                rows[id * laneWords + (s - first) / 64] = 0;
+        }
+    }
+}
+
+/*
+* eligibleBatch: Workers claim blocks of 256 students from a shared counter, each with its own
+*                scratch rows, and write straight into their students' slices of the result.
+*/
+EligibilityBatch EligibilityEngine::eligibleBatch(const std::vector<std::vector<std::uint32_t>>& students,
+                                                  unsigned threads) const {
+    EligibilityBatch batch;
+    batch.students = students.size();
+    batch.wordsPerStudent = wordCount;
+    batch.words.assign(students.size() * wordCount, 0);
+
+    std::size_t blockCount = (students.size() + blockStudents - 1) / blockStudents;
+    std::atomic<std::size_t> next{ 0 };
+    auto work = [&]() {
+        std::vector<std::uint64_t> rows(courseCount * laneWords, 0);
+        for (std::size_t b; (b = next.fetch_add(1, std::memory_order_relaxed)) < blockCount;) {
+            std::size_t first = b * blockStudents;
+            evaluateBlock(students, first, std::min(students.size(), first + blockStudents), rows, batch);
+        }
+    };
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned workerCount = static_cast<unsigned>(std::min<std::size_t>(threads, blockCount));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < workerCount; ++t)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+    return batch;
+}
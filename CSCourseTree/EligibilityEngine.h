@@ -0,0 +1,119 @@
+/*
+    File: EligibilityEngine.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: EligibilityEngine, EligibilityBatch
+    Description: Bitset evaluation of "which courses can a student take next", for one student
+                 or thousands at a time
+*/
+#ifndef ELIGIBILITY_ENGINE_H
+#define ELIGIBILITY_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PrerequisiteGraph.h"
+
+/*
+* Structure: EligibilityBatch
+* Description: Eligible courses for each student of a batch, one bitset per student laid end
+*              to end: student s's set is words[s * wordsPerStudent ..], bit id % 64 of word
+*              id / 64. A bitset is usually far smaller than the ID list it stands for, since
+*              every course without prerequisites is eligible for nearly everyone.
+*/
+struct EligibilityBatch {
+    std::size_t students = 0;
+    std::size_t wordsPerStudent = 0;
+    std::vector<std::uint64_t> words;
+
+    std::size_t studentCount() const { return students; }
+
+    // Student s's eligible set (wordsPerStudent words).
+    const std::uint64_t* student(std::size_t s) const { return words.data() + s * wordsPerStudent; }
+
+    bool isEligible(std::size_t s, std::uint32_t id) const {
+        return (student(s)[id / 64] >> (id % 64)) & 1;
+    }
+
+    // Student s's eligible course IDs in increasing order.
+    std::vector<std::uint32_t> courses(std::size_t s) const;
+};
+
+/*
+* Class: EligibilityEngine
+* Description: Answers the advising query "given what a student has completed, which courses
+*              have all their prerequisites met?" without touching the tree. Courses are the
+*              bit positions of the graph's dense IDs. Each course's prerequisite set is stored
+*              as a sparse bitset: one (word, mask) term per 64-bit word it touches. A student's
+*              completed set is a dense bitset, so a course is eligible when every term passes
+*              (completed[word] & mask) == mask.
+*
+*              Batches are bit-sliced instead: students are taken 256 at a time, and for every
+*              course a 256-bit row records which of them completed it. A course's eligible
+*              row is then the AND of its prerequisites' rows, so one pass over the
+*              prerequisite arrays answers all 256 students. The rows are four-word arrays
+*              that compilers turn into SIMD ANDs. Every 64 courses, the rows are transposed
+*              back into each student's bitset with 64x64 bit-matrix transposes. Blocks are
+*              spread over worker threads.
+*
+*              Completed courses are left out of the results, and prerequisite names that
+*              match no course are ignored, as PrerequisiteGraph leaves them out. The engine
+*              copies the prerequisite sets but keeps using the graph to look up course
+*              numbers, so the graph must outlive it and be rebuilt (with the engine) after
+*              the tree changes.
+*/
+class EligibilityEngine {
+public:
+    // A set of course IDs, bit id % 64 of word id / 64.
+    using Bitset = std::vector<std::uint64_t>;
+
+    explicit EligibilityEngine(const PrerequisiteGraph& graph);
+
+    // Number of courses (bit positions).
+    std::size_t size() const { return courseCount; }
+
+    // Completed-set bitset for the given course IDs (IDs out of range are ignored).
+    Bitset completedSet(const std::vector<std::uint32_t>& completedIds) const;
+
+    // Completed-set bitset for the given course numbers (unknown numbers are ignored).
+    Bitset completedSet(const std::vector<std::string>& completedNumbers) const;
+
+    // Courses the student has not completed whose prerequisites are all in completed, as a
+    // bitset of size() bits. A shorter completed set is treated as padded with zeros.
+    Bitset eligibleSet(const Bitset& completed) const;
+
+    // Same as eligibleSet, as a list of course IDs in increasing order.
+    std::vector<std::uint32_t> eligible(const Bitset& completed) const;
+
+    // Evaluates many students in one call; students[s] lists student s's completed course
+    // IDs. threads: workers for the blocks of 256 students (0 = one per hardware thread).
+    // The result takes about students.size() * size() / 8 bytes.
+    EligibilityBatch eligibleBatch(const std::vector<std::vector<std::uint32_t>>& students,
+                                   unsigned threads = 0) const;
+
+private:
+    static constexpr std::size_t laneWords = 4;                 // 64-bit words per row
+    static constexpr std::size_t blockStudents = 64 * laneWords;
+
+    const PrerequisiteGraph& graph;                 // for idOf only
+    std::size_t courseCount = 0;
+    std::size_t wordCount = 0;                      // words in a dense bitset
+
+    // Single-student form: every course's (word, mask) terms, grouped by course.
+    std::vector<std::uint32_t> termCourses;         // term -> course it belongs to
+    std::vector<std::uint32_t> termWords;           // term -> word of the completed set
+    std::vector<std::uint64_t> termMasks;           // term -> prerequisite bits in that word
+
+    // Batch form: course -> its distinct prerequisite IDs.
+    std::vector<std::uint32_t> prereqOffsets;       // size() + 1 row offsets into prereqIds
+    std::vector<std::uint32_t> prereqIds;
+
+    // Evaluates students[first .. last) (at most blockStudents) with the bit-sliced kernel,
+    // writing their eligible sets into batch. rows must hold size() rows and be all zero;
+    // it is left all zero.
+    void evaluateBlock(const std::vector<std::vector<std::uint32_t>>& students, std::size_t first,
+                       std::size_t last, std::vector<std::uint64_t>& rows, EligibilityBatch& batch) const;
+};
+
+#endif
@@ -0,0 +1,258 @@
+/*
+    File: FrozenCatalog.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: FrozenCatalog
+    Description: Eytzinger-layout build, branch-free search and range queries
+*/
+
+#include "FrozenCatalog.h"
+#include <algorithm>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define PREFETCH_KEYS(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#else
+#define PREFETCH_KEYS(p) __builtin_prefetch(p)
+#endif
+
+namespace {
+    constexpr std::size_t cacheLine = 64;
+
+    // The arrays fillEytzinger writes, indexed by slot.
+    struct Layout {
+        std::uint64_t* keys;
+        std::uint64_t* tails;
+        std::uint32_t* ranks;
+        std::uint64_t* longSlots;
+    };
+
+    // Key arrays start on a cache line, so slot 8k's line holds exactly slots 8k..8k+7.
+    std::uint64_t* allocateKeys(std::size_t count) {
+        return static_cast<std::uint64_t*>(::operator new[](count * sizeof(std::uint64_t), std::align_val_t(cacheLine)));
+    }
+
+    /*
+    * fillEytzinger: In-order walk of the implicit tree rooted at slot (children 2k and 2k+1),
+    *                handing out the sorted positions in order, so slot k receives the key its
+    *                node would hold in a complete binary search tree.
+    */
+    void fillEytzinger(const std::vector<Course>& courses, std::size_t prefixLength, const Layout& layout,
+                       std::size_t slot, std::size_t& next) {
+        if (slot > courses.size())
+            return;
+        fillEytzinger(courses, prefixLength, layout, 2 * slot, next);
+        std::string_view rest = std::string_view(courses[next].courseNumber).substr(prefixLength);
+        layout.keys[slot] = CourseKey(rest).packed;
+        layout.tails[slot] = CourseKey(rest.substr(std::min<std::size_t>(8, rest.size()))).packed;
+        if (rest.size() > 16)
+            layout.longSlots[slot / 64] |= std::uint64_t(1) << (slot % 64);
+        layout.ranks[slot] = static_cast<std::uint32_t>(next++);
+        fillEytzinger(courses, prefixLength, layout, 2 * slot + 1, next);
+    }
+
+    // The descent's final slot spells out the path taken; dropping the trailing right turns and
+    // the last left turn leaves the slot where the answer was passed, or 0 if it never turned left.
+    inline std::size_t answerSlot(std::size_t k) {
+        while (k & 1)
+            k >>= 1;
+        return k >> 1;
+    }
+}
+
+void FrozenCatalog::AlignedDelete::operator()(std::uint64_t* keys) const {
+    ::operator delete[](keys, std::align_val_t(cacheLine));
+}
+
+/*
+* FrozenCatalog: Sorts if needed, measures the shared prefix (for sorted input, the common prefix
+*                of the first and last numbers), and lays the keys out in Eytzinger order.
+*/
+FrozenCatalog::FrozenCatalog(std::vector<Course>&& sortedCourses) : courses(std::move(sortedCourses)) {
+    auto byNumber = [](const Course& a, const Course& b) { return a.courseNumber < b.courseNumber; };
+    if (!std::is_sorted(courses.begin(), courses.end(), byNumber))
+        std::stable_sort(courses.begin(), courses.end(), byNumber);
+
+    if (!courses.empty()) {
+        const std::string& first = courses.front().courseNumber;
+        const std::string& last = courses.back().courseNumber;
+        std::size_t limit = std::min(first.size(), last.size());
+        while (prefixLength < limit && first[prefixLength] == last[prefixLength])
+            ++prefixLength;
+    }
+    std::size_t count = courses.size();
+    keys.reset(allocateKeys(count + 1));
+    tails.reset(allocateKeys(count + 1));
+    keys[0] = tails[0] = 0;
+    ranks.assign(count + 1, 0);
+    longSlots.assign(count / 64 + 1, 0);
+    std::size_t next = 0;
+    fillEytzinger(courses, prefixLength, Layout{ keys.get(), tails.get(), ranks.data(), longSlots.data() }, 1, next);
+}
+
+/*
+* makeProbe: A query that does not start with the shared prefix sorts entirely before or after
+*            the catalog; otherwise only the rest of it takes part in the descent.
+*/
+FrozenCatalog::Probe FrozenCatalog::makeProbe(std::string_view courseNumber) const {
+    Probe probe{ 0, 0, 0, false, std::string_view() };
+    if (courses.empty())
+        return probe;
+    probe.side = courseNumber.compare(0, prefixLength, std::string_view(courses.front().courseNumber).substr(0, prefixLength));
+    if (probe.side == 0) {
+        probe.rest = courseNumber.substr(prefixLength);
+        probe.head = CourseKey(probe.rest).packed;
+        probe.tail = CourseKey(probe.rest.substr(std::min<std::size_t>(8, probe.rest.size()))).packed;
+        probe.overflow = probe.rest.size() > 16;
+    }
+    return probe;
+}
+
+/*
+* goesRight: The heads decide unless they tie, then the tails, and only when both tie and
+*            either number is too long to fit is the stored number read. Equal packed keys
+*            with nothing left over are equal numbers.
+*/
+inline bool FrozenCatalog::goesRight(std::size_t slot, const Probe& probe, bool orEqual) const {
+    std::uint64_t slotKey = keys[slot];
+    if (slotKey != probe.head)
+        return slotKey < probe.head;
+    std::uint64_t slotTail = tails[slot];
+    if (slotTail != probe.tail)
+        return slotTail < probe.tail;
+    if (!probe.overflow && !isLong(slot))
+        return orEqual;
+    int cmp = std::string_view(courses[ranks[slot]].courseNumber).substr(prefixLength).compare(probe.rest);
+    return orEqual ? cmp <= 0 : cmp < 0;
+}
+
+/*
+* descend: Lower/upper-bound descent. A cache line holds eight keys, so the line at slot 8k
+*          holds all of slot k's great-grandchildren. Numbers that tie on their heads usually
+*          keep tying further down, so a tie also prefetches the tails three levels below.
+*/
+std::size_t FrozenCatalog::descend(const Probe& probe, bool orEqual) const {
+    std::size_t count = courses.size();
+    std::size_t k = 1;
+    while (k <= count) {
+        std::size_t ahead = std::min(8 * k, count);
+        PREFETCH_KEYS(keys.get() + ahead);
+        if (keys[k] == probe.head)
+            PREFETCH_KEYS(tails.get() + ahead);
+        k = 2 * k + goesRight(k, probe, orEqual);
+    }
+    return answerSlot(k);
+}
+
+std::size_t FrozenCatalog::bound(std::string_view courseNumber, bool orEqual) const {
+    Probe probe = makeProbe(courseNumber);
+    if (probe.side != 0)
+        return probe.side < 0 ? 0 : courses.size();
+    std::size_t slot = descend(probe, orEqual);
+    return slot ? ranks[slot] : courses.size();
+}
+
+const Course* FrozenCatalog::resolve(std::size_t slot, const Probe& probe) const {
+    if (slot == 0 || keys[slot] != probe.head || tails[slot] != probe.tail)
+        return nullptr;
+    const Course& course = courses[ranks[slot]];
+    if ((probe.overflow || isLong(slot)) && std::string_view(course.courseNumber).substr(prefixLength) != probe.rest)
+        return nullptr;
+    return &course;
+}
+
+const Course* FrozenCatalog::find(std::string_view courseNumber) const {
+    Probe probe = makeProbe(courseNumber);
+    if (probe.side != 0)
+        return nullptr;
+    return resolve(descend(probe, false), probe);
+}
+
+std::optional<Course> FrozenCatalog::search(std::string_view courseNumber) const {
+    const Course* course = find(courseNumber);
+    if (!course)
+        return std::nullopt;
+    return *course;
+}
+
+/*
+* searchLanes: Runs up to laneCount descents side by side. Each round moves every unfinished
+*              lane down one level and prefetches three levels ahead, so the lanes' misses are
+*              in flight together instead of one after another. Slot 0 marks a lane whose key
+*              cannot match.
+*/
+template <typename Key>
+void FrozenCatalog::searchLanes(const Key* numbers, std::size_t count, const Course** results) const {
+    constexpr std::size_t laneCount = 8;
+    std::size_t total = courses.size();
+    Probe probes[laneCount];
+    std::size_t lanes[laneCount];
+    for (std::size_t base = 0; base < count; base += laneCount) {
+        std::size_t width = std::min(laneCount, count - base);
+        for (std::size_t i = 0; i < width; ++i) {
+            probes[i] = makeProbe(numbers[base + i]);
+            lanes[i] = probes[i].side == 0 ? 1 : 0;
+        }
+        for (bool active = true; active;) {
+            active = false;
+            for (std::size_t i = 0; i < width; ++i) {
+                std::size_t k = lanes[i];
+                if (k == 0 || k > total)
+                    continue;
+                std::size_t ahead = std::min(8 * k, total);
+                PREFETCH_KEYS(keys.get() + ahead);
+                if (keys[k] == probes[i].head)
+                    PREFETCH_KEYS(tails.get() + ahead);
+                lanes[i] = 2 * k + goesRight(k, probes[i], false);
+                active = true;
+            }
+        }
+        for (std::size_t i = 0; i < width; ++i)
+            results[base + i] = lanes[i] ? resolve(answerSlot(lanes[i]), probes[i]) : nullptr;
+    }
+}
+
+void FrozenCatalog::searchBatch(const std::string* numbers, std::size_t count, const Course** results) const {
+    searchLanes(numbers, count, results);
+}
+
+void FrozenCatalog::searchBatch(const std::string_view* numbers, std::size_t count, const Course** results) const {
+    searchLanes(numbers, count, results);
+}
+
+void FrozenCatalog::searchBatch(const std::vector<std::string>& numbers, std::vector<const Course*>& results) const {
+    results.resize(numbers.size());
+    searchBatch(numbers.data(), numbers.size(), results.data());
+}
+
+void FrozenCatalog::searchBatch(const std::vector<std::string_view>& numbers, std::vector<const Course*>& results) const {
+    results.resize(numbers.size());
+    searchBatch(numbers.data(), numbers.size(), results.data());
+}
+
+FrozenCatalog::const_iterator FrozenCatalog::lower_bound(std::string_view courseNumber) const {
+    return courses.begin() + static_cast<std::ptrdiff_t>(bound(courseNumber, false));
+}
+
+FrozenCatalog::const_iterator FrozenCatalog::upper_bound(std::string_view courseNumber) const {
+    return courses.begin() + static_cast<std::ptrdiff_t>(bound(courseNumber, true));
+}
+
+std::pair<FrozenCatalog::const_iterator, FrozenCatalog::const_iterator>
+FrozenCatalog::equal_range(std::string_view courseNumber) const {
+    return { lower_bound(courseNumber), upper_bound(courseNumber) };
+}
+
+// prefixRange: Same bounds as RedBlackTree::prefixRange, [prefix, prefix with its last
+// non-0xFF character incremented).
+std::pair<FrozenCatalog::const_iterator, FrozenCatalog::const_iterator>
+FrozenCatalog::prefixRange(std::string_view prefix) const {
+    std::string limit(prefix);
+    while (!limit.empty() && static_cast<unsigned char>(limit.back()) == 0xFF)
+        limit.pop_back();
+    if (limit.empty())
+        return { lower_bound(prefix), end() };
+    limit.back() = static_cast<char>(static_cast<unsigned char>(limit.back()) + 1);
+    return { lower_bound(prefix), lower_bound(limit) };
+}
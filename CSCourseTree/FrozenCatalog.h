@@ -0,0 +1,129 @@
+/*
+    File: FrozenCatalog.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: FrozenCatalog
+    Description: Immutable, cache-friendly search structure compiled from a RedBlackTree
+*/
+#ifndef FROZEN_CATALOG_H
+#define FROZEN_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Course.h"
+
+/*
+* Class: FrozenCatalog
+* Description: Read-only copy of a catalog for the serving phase after load. The courses sit in
+*              one array in course-number order. The prefix every number shares is stripped
+*              (B-tree style prefix truncation), and the next eight characters are packed into
+*              keys laid out in Eytzinger (breadth-first) order in a 64-byte-aligned array; a
+*              parallel array holds the eight after those and is read only when keys tie. A
+*              lookup descends the key array without data-dependent branches. The top levels
+*              stay in cache, and each step prefetches the cache line holding the keys three
+*              levels below, so most of a search's memory latency overlaps. Range queries
+*              return iterators into the sorted array, so scanning a range reads contiguous
+*              memory. Built with RedBlackTree::freeze(); it owns its copies and does not
+*              depend on the tree.
+*/
+class FrozenCatalog {
+public:
+    using const_iterator = std::vector<Course>::const_iterator;
+
+    FrozenCatalog() = default;
+
+    // Builds from the given courses. Input that is not already sorted by course number is
+    // stable-sorted first, so duplicate numbers keep their order.
+    explicit FrozenCatalog(std::vector<Course>&& courses);
+
+    // The stored course with this number, or null. Pointers stay valid for the catalog's lifetime.
+    const Course* find(std::string_view courseNumber) const;
+
+    // Searches for a course by course number, like RedBlackTree::search.
+    std::optional<Course> search(std::string_view courseNumber) const;
+
+    // Looks up count course numbers at once, writing a pointer to each course (or null) into
+    // results[i]. Descents run in groups of eight in lockstep, so their cache misses overlap.
+    void searchBatch(const std::string* keys, std::size_t count, const Course** results) const;
+    void searchBatch(const std::string_view* keys, std::size_t count, const Course** results) const;
+
+    // Convenience overloads; resize results to keys.size().
+    void searchBatch(const std::vector<std::string>& keys, std::vector<const Course*>& results) const;
+    void searchBatch(const std::vector<std::string_view>& keys, std::vector<const Course*>& results) const;
+
+    // Courses in course-number order.
+    const_iterator begin() const { return courses.begin(); }
+    const_iterator end() const { return courses.end(); }
+
+    // First course whose number is not less than courseNumber.
+    const_iterator lower_bound(std::string_view courseNumber) const;
+
+    // First course whose number is greater than courseNumber.
+    const_iterator upper_bound(std::string_view courseNumber) const;
+
+    // All courses with exactly this number.
+    std::pair<const_iterator, const_iterator> equal_range(std::string_view courseNumber) const;
+
+    // All courses whose number starts with prefix (e.g. "CSCI").
+    std::pair<const_iterator, const_iterator> prefixRange(std::string_view prefix) const;
+
+    std::size_t size() const { return courses.size(); }
+    bool empty() const { return courses.empty(); }
+
+    // Bytes held by the key, tail and rank arrays (the search structure itself, not the courses).
+    std::size_t indexBytes() const {
+        return (courses.size() + 1) * (2 * sizeof(std::uint64_t) + sizeof(std::uint32_t))
+            + longSlots.size() * sizeof(std::uint64_t);
+    }
+
+private:
+    struct AlignedDelete {
+        void operator()(std::uint64_t* keys) const;
+    };
+
+    // A query course number, split at the prefix every stored number shares.
+    struct Probe {
+        int side;               // <0 / >0: sorts before / after every course; 0: shares the prefix
+        std::uint64_t head;     // next eight characters after the prefix, packed
+        std::uint64_t tail;     // the eight after those, packed
+        bool overflow;          // more than sixteen characters after the prefix
+        std::string_view rest;  // characters after the prefix
+    };
+
+    std::vector<Course> courses;                            // sorted by course number
+    std::unique_ptr<std::uint64_t[], AlignedDelete> keys;   // slot -> packed head, slots 1..size()
+    std::unique_ptr<std::uint64_t[], AlignedDelete> tails;  // slot -> packed tail, read on head ties
+    std::vector<std::uint32_t> ranks;                       // slot -> index into courses
+    std::size_t prefixLength = 0;                           // characters every course number shares
+    std::vector<std::uint64_t> longSlots;                   // slot -> bit set when the number has more
+                                                            // than sixteen characters after the prefix
+
+    bool isLong(std::size_t slot) const { return (longSlots[slot / 64] >> (slot % 64)) & 1; }
+
+    Probe makeProbe(std::string_view courseNumber) const;
+
+    // The searchBatch loop, shared by the string and string_view overloads.
+    template <typename Key>
+    void searchLanes(const Key* numbers, std::size_t count, const Course** results) const;
+
+    // One descent step: true when the course in slot sorts before the probe (orEqual: is not
+    // after it), so the search continues in the right subtree.
+    bool goesRight(std::size_t slot, const Probe& probe, bool orEqual) const;
+
+    // Slot of the first course not less than (orEqual: greater than) the probe, or 0 if none.
+    std::size_t descend(const Probe& probe, bool orEqual) const;
+
+    // Index of the first course not less than (orEqual: greater than) courseNumber.
+    std::size_t bound(std::string_view courseNumber, bool orEqual) const;
+
+    // The course in slot if its number equals the probe's, or null.
+    const Course* resolve(std::size_t slot, const Probe& probe) const;
+};
+
+#endif
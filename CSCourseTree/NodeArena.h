@@ -0,0 +1,158 @@
+/*
+    File: NodeArena.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: NodeArena
+    Description: Block-based node pool that owns every node of a Red-Black Tree
+*/
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/*
+* Class: NodeArena
+* Description: Hands out nodes from large contiguous blocks instead of one heap
+*              allocation per node. Nodes never move once created, so raw
+*              pointers to them stay valid until destroy(), clear() or destruction;
+*              the last two release the whole pool in one shot. Destroyed slots go on
+*              a free list and are reused by the next create(). The blocks come from
+*              Allocator (rebound to the slot type); it moves with them.
+*/
+template <typename T, typename Allocator = std::allocator<T>>
+class NodeArena {
+private:
+    // Raw, correctly aligned storage for one node.
+    struct alignas(T) Slot {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+    SlotAllocator allocator;                      // Source of the blocks
+    std::vector<Slot*> blocks;                    // Every block holds blockSize slots
+    std::size_t blockSize;                        // Slots per block
+    std::size_t used;                             // Slots handed out so far
+    std::vector<T*> freeSlots;                    // Destroyed slots waiting to be reused
+
+    void addBlock() {
+        blocks.push_back(SlotTraits::allocate(allocator, blockSize));
+    }
+
+public:
+    explicit NodeArena(std::size_t nodesPerBlock = 4096, const Allocator& alloc = Allocator())
+        : allocator(alloc), blockSize(nodesPerBlock ? nodesPerBlock : 1), used(0) {
+    }
+
+    ~NodeArena() { clear(); }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    NodeArena(NodeArena&& other) noexcept
+        : allocator(std::move(other.allocator)), blocks(std::move(other.blocks)), blockSize(other.blockSize),
+          used(other.used), freeSlots(std::move(other.freeSlots)) {
+        other.blocks.clear();
+        other.used = 0;
+        other.freeSlots.clear();
+    }
+
+    NodeArena& operator=(NodeArena&& other) noexcept {
+        if (this != &other) {
+            clear();
+            allocator = std::move(other.allocator);
+            blocks = std::move(other.blocks);
+            blockSize = other.blockSize;
+            used = other.used;
+            freeSlots = std::move(other.freeSlots);
+            other.blocks.clear();
+            other.used = 0;
+            other.freeSlots.clear();
+        }
+        return *this;
+    }
+
+    // Constructs a node in a recycled slot if one is free, otherwise in the next unused
+    // slot, adding a block when the last one is full.
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (!freeSlots.empty()) {
+            T* slot = freeSlots.back();
+            T* node = ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+            freeSlots.pop_back();
+            return node;
+        }
+        if (used == blocks.size() * blockSize)
+            addBlock();
+        Slot& slot = blocks[used / blockSize][used % blockSize];
+        T* node = ::new (static_cast<void*>(slot.bytes)) T(std::forward<Args>(args)...);
+        ++used;
+        return node;
+    }
+
+    // Destroys one node and puts its slot on the free list.
+    void destroy(T* node) {
+        node->~T();
+        freeSlots.push_back(node);
+    }
+
+    // Destroys every live node and releases all blocks. Free slots are skipped by sorting the
+    // free list and walking it alongside the slots, block by block in address order: no
+    // hashing, and the only allocation is one index per block.
+    void clear() {
+        if (freeSlots.empty()) {
+            for (std::size_t i = 0; i < used; ++i)
+                std::launder(reinterpret_cast<T*>(blocks[i / blockSize][i % blockSize].bytes))->~T();
+        }
+        else {
+            std::less<const void*> before;
+            std::sort(freeSlots.begin(), freeSlots.end(), before);
+            std::vector<std::size_t> order(blocks.size());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::sort(order.begin(), order.end(),
+                      [&](std::size_t a, std::size_t b) { return before(blocks[a], blocks[b]); });
+            auto nextFree = freeSlots.begin();
+            for (std::size_t b : order) {
+                std::size_t first = b * blockSize;
+                std::size_t count = used > first ? std::min(blockSize, used - first) : 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    void* slot = blocks[b][i].bytes;
+                    if (nextFree != freeSlots.end() && *nextFree == slot)
+                        ++nextFree;
+                    else
+                        std::launder(reinterpret_cast<T*>(slot))->~T();
+                }
+            }
+        }
+        for (Slot* block : blocks)
+            SlotTraits::deallocate(allocator, block, blockSize);
+        blocks.clear();
+        freeSlots.clear();
+        used = 0;
+    }
+
+    // Pre-allocates enough blocks to hold count nodes without further growth.
+    void reserve(std::size_t count) {
+        while (blocks.size() * blockSize < count)
+            addBlock();
+    }
+
+    // Number of live nodes.
+    std::size_t size() const { return used - freeSlots.size(); }
+
+    // The allocator the blocks come from.
+    Allocator get_allocator() const { return Allocator(allocator); }
+
+    // Bytes reserved for node storage, including unused slots in the last block.
+    std::size_t bytesReserved() const { return blocks.size() * blockSize * sizeof(Slot); }
+};
+
+#endif
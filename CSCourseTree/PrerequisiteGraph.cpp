@@ -0,0 +1,156 @@
+/*
+    File: PrerequisiteGraph.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Builds and queries the resolved prerequisite index
+*/
+
+#include "PrerequisiteGraph.h"
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+* build: Assigns IDs in course-number order, resolves each prerequisite name by binary search
+*        over the packed keys, then derives the reverse adjacency with a counting pass.
+*/
+void PrerequisiteGraph::build(const RedBlackTree& tree) {
+    courses.clear();
+    keys.clear();
+    prereqOffsets.clear();
+    prereqTargets.clear();
+    dependentOffsets.clear();
+    dependentTargets.clear();
+    dangling.clear();
+
+    courses.reserve(tree.size());
+    keys.reserve(tree.size());
+    tree.forEachInOrder([this](const Course& course) {
+        courses.push_back(&course);
+        keys.emplace_back(course.courseNumber);
+    });
+
+    // Forward adjacency: one row per course, unknown names collected for a single report.
+    std::unordered_map<std::string_view, std::size_t> danglingIndex;
+    prereqOffsets.reserve(courses.size() + 1);
+    prereqOffsets.push_back(0);
+    for (const Course* course : courses) {
+        for (const auto& prereq : course->prerequisites) {
+            std::uint32_t target = idOf(prereq);
+            if (target != npos) {
+                prereqTargets.push_back(target);
+                continue;
+            }
+            auto found = danglingIndex.find(prereq);
+            if (found == danglingIndex.end()) {
+                danglingIndex.emplace(prereq, dangling.size());
+                dangling.push_back({ prereq, course->courseNumber, 1 });
+            }
+            else {
+                ++dangling[found->second].referenceCount;
+            }
+        }
+        prereqOffsets.push_back(static_cast<std::uint32_t>(prereqTargets.size()));
+    }
+
+    // Reverse adjacency: count in-edges, prefix-sum into offsets, then scatter.
+    dependentOffsets.assign(courses.size() + 1, 0);
+    for (std::uint32_t target : prereqTargets)
+        ++dependentOffsets[target + 1];
+    for (std::size_t i = 1; i < dependentOffsets.size(); ++i)
+        dependentOffsets[i] += dependentOffsets[i - 1];
+    dependentTargets.resize(prereqTargets.size());
+    std::vector<std::uint32_t> cursor(dependentOffsets.begin(), dependentOffsets.end() - 1);
+    for (std::uint32_t id = 0; id < courses.size(); ++id) {
+        for (std::uint32_t target : prerequisitesOf(id))
+            dependentTargets[cursor[target]++] = id;
+    }
+
+    for (const auto& missing : dangling) {
+        std::cerr << "Warning: Unknown prerequisite " << missing.prerequisite
+                  << " (first listed by " << missing.firstReferencedBy << ", "
+                  << missing.referenceCount << " reference(s))" << std::endl;
+    }
+}
+
+/*
+* idOf: Binary search over the packed keys; duplicates resolve to the first matching ID.
+*/
+std::uint32_t PrerequisiteGraph::idOf(std::string_view courseNumber) const {
+    CourseKey key(courseNumber);
+    std::size_t lo = 0;
+    std::size_t hi = keys.size();
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (compareCourseKeys(keys[mid], courses[mid]->courseNumber, key, courseNumber) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < keys.size() && compareCourseKeys(keys[lo], courses[lo]->courseNumber, key, courseNumber) == 0)
+        return static_cast<std::uint32_t>(lo);
+    return npos;
+}
+
+/*
+* VisitMarks::begin: Pass 0 is never used, so zeroed stamps mean "not reached".
+*/
+void PrerequisiteGraph::VisitMarks::begin(std::size_t n) {
+    if (stamps.size() != n || pass == UINT32_MAX) {
+        stamps.assign(n, 0);
+        pass = 0;
+    }
+    ++pass;
+}
+
+/*
+* reachable: Breadth-first traversal; the output vector doubles as the work queue. The start
+*            is not marked up front, so it is only added if some edge leads back to it.
+*/
+template <typename FirstVisit>
+void PrerequisiteGraph::reachable(std::uint32_t id, const std::vector<std::uint32_t>& offsets,
+                                  const std::vector<std::uint32_t>& targets, FirstVisit&& firstVisit,
+                                  std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (id >= courses.size())
+        return;
+    auto expand = [&](std::uint32_t current) {
+        for (std::uint32_t i = offsets[current]; i < offsets[current + 1]; ++i) {
+            if (firstVisit(targets[i]))
+                out.push_back(targets[i]);
+        }
+    };
+    expand(id);
+    for (std::size_t next = 0; next < out.size(); ++next)
+        expand(out[next]);
+}
+
+/*
+* allPrerequisites: Full prerequisite chain of a course.
+*/
+std::vector<std::uint32_t> PrerequisiteGraph::allPrerequisites(std::uint32_t id) const {
+    std::unordered_set<std::uint32_t> seen;
+    std::vector<std::uint32_t> out;
+    reachable(id, prereqOffsets, prereqTargets, [&](std::uint32_t target) { return seen.insert(target).second; }, out);
+    return out;
+}
+
+void PrerequisiteGraph::allPrerequisites(std::uint32_t id, VisitMarks& marks, std::vector<std::uint32_t>& out) const {
+    marks.begin(courses.size());
+    reachable(id, prereqOffsets, prereqTargets, [&](std::uint32_t target) { return marks.mark(target); }, out);
+}
+
+/*
+* allDependents: Every course that needs this one somewhere in its chain.
+*/
+std::vector<std::uint32_t> PrerequisiteGraph::allDependents(std::uint32_t id) const {
+    std::unordered_set<std::uint32_t> seen;
+    std::vector<std::uint32_t> out;
+    reachable(id, dependentOffsets, dependentTargets, [&](std::uint32_t target) { return seen.insert(target).second; }, out);
+    return out;
+}
+
+void PrerequisiteGraph::allDependents(std::uint32_t id, VisitMarks& marks, std::vector<std::uint32_t>& out) const {
+    marks.begin(courses.size());
+    reachable(id, dependentOffsets, dependentTargets, [&](std::uint32_t target) { return marks.mark(target); }, out);
+}
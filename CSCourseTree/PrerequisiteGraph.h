@@ -0,0 +1,136 @@
+/*
+    File: PrerequisiteGraph.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: PrerequisiteGraph
+    Description: Resolved prerequisite index (CSR adjacency) built from a loaded catalog
+*/
+#ifndef PREREQUISITE_GRAPH_H
+#define PREREQUISITE_GRAPH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+
+/*
+* Class: PrerequisiteGraph
+* Description: Gives every course in a RedBlackTree a dense ID (its position in course-number
+*              order) and resolves Course::prerequisites into compressed-sparse-row arrays,
+*              both forward (prerequisites of a course) and reverse (courses that require it).
+*              Recursive queries then walk integer arrays instead of doing tree lookups.
+*              The graph points at the tree's courses, so it must be rebuilt after the tree
+*              changes.
+*/
+class PrerequisiteGraph {
+public:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    // Contiguous run of course IDs inside one of the adjacency arrays.
+    struct IdRange {
+        const std::uint32_t* first;
+        const std::uint32_t* last;
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    // A prerequisite name that matched no course, with the first course that listed it.
+    struct DanglingPrerequisite {
+        std::string prerequisite;
+        std::string firstReferencedBy;
+        std::size_t referenceCount;
+    };
+
+    PrerequisiteGraph() = default;
+
+    // Builds the index from the tree. Unknown prerequisite names are reported once each
+    // on std::cerr and left out of the adjacency arrays.
+    void build(const RedBlackTree& tree);
+
+    // Number of courses (IDs run from 0 to size() - 1).
+    std::size_t size() const { return courses.size(); }
+
+    // Looks up a course ID by number; returns npos if it is not in the catalog.
+    std::uint32_t idOf(std::string_view courseNumber) const;
+
+    // The course with the given ID.
+    const Course& course(std::uint32_t id) const { return *courses[id]; }
+
+    // Direct prerequisites of a course.
+    IdRange prerequisitesOf(std::uint32_t id) const {
+        return { prereqTargets.data() + prereqOffsets[id], prereqTargets.data() + prereqOffsets[id + 1] };
+    }
+
+    // Courses that list this course as a direct prerequisite.
+    IdRange dependentsOf(std::uint32_t id) const {
+        return { dependentTargets.data() + dependentOffsets[id], dependentTargets.data() + dependentOffsets[id + 1] };
+    }
+
+    /*
+    * Class: VisitMarks
+    * Description: Reusable visited marks for the closure queries. Each query stamps the
+    *              courses it reaches with a new pass number instead of clearing a flag per
+    *              course, so after the first query a closure costs O(result), not O(size()).
+    *              Not shared: keep one per thread.
+    */
+    class VisitMarks {
+    private:
+        friend class PrerequisiteGraph;
+        std::vector<std::uint32_t> stamps;      // course ID -> pass that last reached it
+        std::uint32_t pass = 0;
+
+        // Starts a walk over n courses; sizes and clears the stamps only when n changes or
+        // the pass counter wraps.
+        void begin(std::size_t n);
+
+        // True the first time this pass reaches id.
+        bool mark(std::uint32_t id) {
+            if (stamps[id] == pass)
+                return false;
+            stamps[id] = pass;
+            return true;
+        }
+    };
+
+    // Every course reachable through prerequisite links (the full chain), in discovery order.
+    // The course itself is included only if it lies on a prerequisite cycle, i.e. it ends up
+    // requiring itself. Tracks visits in a hash set sized to the result.
+    std::vector<std::uint32_t> allPrerequisites(std::uint32_t id) const;
+
+    // Same, written into out, with marks reused across calls.
+    void allPrerequisites(std::uint32_t id, VisitMarks& marks, std::vector<std::uint32_t>& out) const;
+
+    // Every course that directly or indirectly requires this one, in discovery order. As with
+    // allPrerequisites, the course itself is included only if it is on a cycle.
+    std::vector<std::uint32_t> allDependents(std::uint32_t id) const;
+
+    // Same, written into out, with marks reused across calls.
+    void allDependents(std::uint32_t id, VisitMarks& marks, std::vector<std::uint32_t>& out) const;
+
+    // Unknown prerequisite names found by the last build().
+    const std::vector<DanglingPrerequisite>& danglingPrerequisites() const { return dangling; }
+
+    // Total number of resolved prerequisite edges.
+    std::size_t edgeCount() const { return prereqTargets.size(); }
+
+private:
+    std::vector<const Course*> courses;             // ID -> course, in course-number order
+    std::vector<CourseKey> keys;                    // ID -> packed course number, for idOf
+    std::vector<std::uint32_t> prereqOffsets;       // size() + 1 row offsets into prereqTargets
+    std::vector<std::uint32_t> prereqTargets;
+    std::vector<std::uint32_t> dependentOffsets;    // size() + 1 row offsets into dependentTargets
+    std::vector<std::uint32_t> dependentTargets;
+    std::vector<DanglingPrerequisite> dangling;
+
+    // Breadth-first walk over one of the CSR arrays starting at id. firstVisit(target) returns
+    // true the first time the walk reaches target.
+    template <typename FirstVisit>
+    void reachable(std::uint32_t id, const std::vector<std::uint32_t>& offsets,
+                   const std::vector<std::uint32_t>& targets, FirstVisit&& firstVisit,
+                   std::vector<std::uint32_t>& out) const;
+};
+
+#endif
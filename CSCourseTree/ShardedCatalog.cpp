@@ -0,0 +1,212 @@
+/*
+    File: ShardedCatalog.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: ShardedCatalog
+    Description: Parallel shard build and refresh, and routing of lookups to shards
+*/
+
+#include "ShardedCatalog.h"
+#include "CsvLoader.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+ShardedCatalog::ShardedCatalog(unsigned threads)
+    : threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+std::string_view ShardedCatalog::departmentOf(std::string_view courseNumber) {
+    std::size_t length = 0;
+    while (length < courseNumber.size()
+           && ((courseNumber[length] >= 'A' && courseNumber[length] <= 'Z')
+               || (courseNumber[length] >= 'a' && courseNumber[length] <= 'z')))
+        ++length;
+    return courseNumber.substr(0, length);
+}
+
+bool ShardedCatalog::readRecords(const std::string& fileName, std::vector<Course>& courses) const {
+    MappedFile file;
+    if (!file.open(fileName)) {
+        std::cerr << "Failed to open the file: " << fileName << std::endl;
+        return false;
+    }
+    std::vector<CsvParseError> errors;
+    parseCourseCsvParallel(file.view(), courses, errors, threads);
+    reportParseErrors(errors);
+    return true;
+}
+
+std::map<std::string, std::vector<Course>, std::less<>> ShardedCatalog::partition(std::vector<Course>&& courses) {
+    std::map<std::string, std::vector<Course>, std::less<>> groups;
+    std::vector<Course>* group = nullptr;
+    std::string_view groupName;
+    for (auto& course : courses) {
+        // Catalog files are usually grouped by department, so the last group is checked first.
+        std::string_view department = departmentOf(course.courseNumber);
+        if (!group || department != groupName) {
+            auto it = groups.find(department);
+            if (it == groups.end())
+                it = groups.emplace(std::string(department), std::vector<Course>()).first;
+            group = &it->second;
+            groupName = it->first;
+        }
+        group->push_back(std::move(course));
+    }
+    courses.clear();
+    return groups;
+}
+
+/*
+* runParallel: Workers claim indices from a shared counter, so one large department does not
+*              hold up the rest; the calling thread works too.
+*/
+void ShardedCatalog::runParallel(std::size_t count, const std::function<void(std::size_t)>& task) const {
+    std::atomic<std::size_t> next{ 0 };
+    auto work = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+            task(i);
+    };
+    std::vector<std::thread> workers;
+    unsigned workerCount = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+    for (unsigned t = 1; t < workerCount; ++t)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+/*
+* load: The new shards are built off to the side, without any locks, and swapped in at the end,
+*       so readers see either the old catalog or the new one.
+*/
+bool ShardedCatalog::load(const std::string& fileName) {
+    std::vector<Course> courses;
+    if (!readRecords(fileName, courses))
+        return false;
+    auto groups = partition(std::move(courses));
+
+    ShardMap built;
+    std::vector<std::pair<Shard*, std::vector<Course>*>> work;
+    for (auto& [department, records] : groups) {
+        Shard* shard = built.emplace(department, std::make_unique<Shard>()).first->second.get();
+        work.emplace_back(shard, &records);
+    }
+    runParallel(work.size(), [&](std::size_t i) {
+        work[i].first->tree.reload(std::move(*work[i].second));
+    });
+
+    {
+        std::unique_lock<std::shared_mutex> directoryLock(directoryMutex);
+        shards.swap(built);
+    }
+    return true;  // the old shards are freed here, outside the lock
+}
+
+/*
+* reload: Shards for new departments are added first; then every shard is diffed against its
+*         records (none, for a department that has left the file) on the worker pool.
+*/
+ReloadSummary ShardedCatalog::reload(const std::string& fileName) {
+    ReloadSummary total;
+    std::vector<Course> courses;
+    if (!readRecords(fileName, courses))
+        return total;
+    auto groups = partition(std::move(courses));
+
+    {
+        std::unique_lock<std::shared_mutex> directoryLock(directoryMutex);
+        for (const auto& group : groups) {
+            if (shards.find(group.first) == shards.end())
+                shards.emplace(group.first, std::make_unique<Shard>());
+        }
+    }
+
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    std::vector<Shard*> targets;
+    std::vector<std::vector<Course>> records;
+    for (auto& [department, shard] : shards) {
+        targets.push_back(shard.get());
+        auto group = groups.find(department);
+        records.push_back(group != groups.end() ? std::move(group->second) : std::vector<Course>());
+    }
+    std::vector<ReloadSummary> summaries(targets.size());
+    runParallel(targets.size(), [&](std::size_t i) {
+        std::unique_lock<std::shared_mutex> shardLock(targets[i]->mutex);
+        summaries[i] = targets[i]->tree.reload(std::move(records[i]));
+    });
+
+    for (const auto& summary : summaries) {
+        total.added += summary.added;
+        total.changed += summary.changed;
+        total.removed += summary.removed;
+        total.unchanged += summary.unchanged;
+    }
+    return total;
+}
+
+/*
+* reloadDepartment: The shard is created if the department is new. The directory is only read
+*                   while the shard is refreshed, so other departments stay available.
+*/
+ReloadSummary ShardedCatalog::reloadDepartment(const std::string& department, const std::string& fileName) {
+    std::vector<Course> courses;
+    if (!readRecords(fileName, courses))
+        return ReloadSummary();
+    std::vector<Course> records;
+    for (auto& course : courses) {
+        if (departmentOf(course.courseNumber) == department)
+            records.push_back(std::move(course));
+    }
+
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    auto it = shards.find(department);
+    while (it == shards.end()) {
+        directoryLock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> writeLock(directoryMutex);
+            if (shards.find(department) == shards.end())
+                shards.emplace(department, std::make_unique<Shard>());
+        }
+        directoryLock.lock();
+        it = shards.find(department);  // a concurrent load may have replaced the map
+    }
+    std::unique_lock<std::shared_mutex> shardLock(it->second->mutex);
+    return it->second->tree.reload(std::move(records));
+}
+
+std::optional<Course> ShardedCatalog::search(std::string_view courseNumber) const {
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    auto it = shards.find(departmentOf(courseNumber));
+    if (it == shards.end())
+        return std::nullopt;
+    std::shared_lock<std::shared_mutex> shardLock(it->second->mutex);
+    return it->second->tree.search(courseNumber);
+}
+
+std::vector<std::string> ShardedCatalog::departments() const {
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    std::vector<std::string> names;
+    names.reserve(shards.size());
+    for (const auto& entry : shards)
+        names.push_back(entry.first);
+    return names;
+}
+
+std::size_t ShardedCatalog::departmentSize(std::string_view department) const {
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    auto it = shards.find(department);
+    if (it == shards.end())
+        return 0;
+    std::shared_lock<std::shared_mutex> shardLock(it->second->mutex);
+    return it->second->tree.size();
+}
+
+std::size_t ShardedCatalog::size() const {
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    std::size_t total = 0;
+    for (const auto& entry : shards) {
+        std::shared_lock<std::shared_mutex> shardLock(entry.second->mutex);
+        total += entry.second->tree.size();
+    }
+    return total;
+}
@@ -0,0 +1,135 @@
+/*
+    File: ShardedCatalog.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: ShardedCatalog
+    Description: Catalog front-end that keeps each department in its own RedBlackTree, so
+                 shards build in parallel and refresh independently
+*/
+#ifndef SHARDED_CATALOG_H
+#define SHARDED_CATALOG_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Course.h"
+
+/*
+* Class: ShardedCatalog
+* Description: Partitions courses by department (the leading letters of the course number)
+*              into independent trees. Loading parses the CSV once and builds every shard on a
+*              worker pool; reloads diff the shards in parallel, and a single department can
+*              be refreshed on its own. Each shard has its own reader/writer lock, so a
+*              refresh blocks only lookups in that department. Point lookups go straight to
+*              the owning shard; ordered traversal merges the shards by course number.
+*/
+class ShardedCatalog {
+public:
+    // threads: workers for parsing, building and reloading (0 = one per hardware thread).
+    explicit ShardedCatalog(unsigned threads = 0);
+
+    ShardedCatalog(const ShardedCatalog&) = delete;
+    ShardedCatalog& operator=(const ShardedCatalog&) = delete;
+
+    // Department of a course number: its leading ASCII letters ("CSCI" for "CSCI300"). Numbers
+    // that do not start with a letter share the "" department.
+    static std::string_view departmentOf(std::string_view courseNumber);
+
+    // Replaces the catalog with the file's courses (the last record for a number wins).
+    // Returns false, leaving the catalog unchanged, if the file cannot be opened.
+    bool load(const std::string& fileName);
+
+    // Brings every shard in line with a new version of the file, like RedBlackTree::reload.
+    // Shards are diffed in parallel, each under its own write lock.
+    ReloadSummary reload(const std::string& fileName);
+
+    // Refreshes one department from the file, ignoring other departments' records. Only that
+    // department's shard is locked.
+    ReloadSummary reloadDepartment(const std::string& department, const std::string& fileName);
+
+    // Searches the owning shard for a course by course number.
+    std::optional<Course> search(std::string_view courseNumber) const;
+
+    // Calls visit(const Course&) for every course in course-number order, merging the shards.
+    // Every shard's read lock is held for the whole walk.
+    template <typename Visitor>
+    void forEachInOrder(Visitor&& visit) const;
+
+    // Departments that have a shard, in order.
+    std::vector<std::string> departments() const;
+
+    // Courses stored for one department (0 if it has no shard).
+    std::size_t departmentSize(std::string_view department) const;
+
+    // Courses stored across all shards.
+    std::size_t size() const;
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;    // readers share; a reload of this shard excludes them
+        RedBlackTree tree;
+    };
+    using ShardMap = std::map<std::string, std::unique_ptr<Shard>, std::less<>>;
+
+    unsigned threads;
+    mutable std::shared_mutex directoryMutex;   // guards the map itself, not the trees
+    ShardMap shards;
+
+    // Maps and parses a catalog file, reporting malformed lines. Returns false if it cannot be opened.
+    bool readRecords(const std::string& fileName, std::vector<Course>& courses) const;
+
+    // Splits records by department, keeping file order within each department.
+    static std::map<std::string, std::vector<Course>, std::less<>> partition(std::vector<Course>&& courses);
+
+    // Runs task(i) for every i in [0, count) on up to threads workers.
+    void runParallel(std::size_t count, const std::function<void(std::size_t)>& task) const;
+};
+
+/*
+* forEachInOrder: k-way merge over the shards' iterators, with the cursors kept in a min-heap
+*                 on their current course number. Departments are usually contiguous runs, so
+*                 a cursor is drained for as long as it stays ahead of every other shard, and
+*                 the heap is touched about once per shard rather than once per course.
+*/
+template <typename Visitor>
+void ShardedCatalog::forEachInOrder(Visitor&& visit) const {
+    using Cursor = std::pair<RedBlackTree::const_iterator, RedBlackTree::const_iterator>;
+    std::shared_lock<std::shared_mutex> directoryLock(directoryMutex);
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    std::vector<Cursor> cursors;
+    locks.reserve(shards.size());
+    for (const auto& entry : shards) {
+        locks.emplace_back(entry.second->mutex);
+        const RedBlackTree& tree = entry.second->tree;
+        if (tree.begin() != tree.end())
+            cursors.emplace_back(tree.begin(), tree.end());
+    }
+
+    auto later = [](const Cursor& a, const Cursor& b) { return a.first->courseNumber > b.first->courseNumber; };
+    std::make_heap(cursors.begin(), cursors.end(), later);
+    while (!cursors.empty()) {
+        std::pop_heap(cursors.begin(), cursors.end(), later);
+        Cursor& cursor = cursors.back();
+        const bool alone = cursors.size() == 1;
+        do {
+            visit(*cursor.first);
+            ++cursor.first;
+        } while (cursor.first != cursor.second
+                 && (alone || cursor.first->courseNumber < cursors.front().first->courseNumber));
+        if (cursor.first != cursor.second)
+            std::push_heap(cursors.begin(), cursors.end(), later);
+        else
+            cursors.pop_back();
+    }
+}
+
+#endif
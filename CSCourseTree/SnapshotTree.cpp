@@ -0,0 +1,498 @@
+/*
+    File: SnapshotTree.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Path-copying Red-Black Tree writes, snapshot reads and epoch-based reclamation
+*/
+
+#include "SnapshotTree.h"
+#include <functional>
+#include <limits>
+#include <thread>
+
+// Null children count as black leaves.
+static Color colorOf(const SnapshotNode* node) {
+    return node ? node->color : BLACK;
+}
+
+SnapshotTree::SnapshotTree()
+    : current(new Version{ nullptr, 0 }), globalEpoch(1), readers(new ReaderBlock),
+      root(nullptr), count(0), writeId(0), pending{ 0, nullptr, {}, {} } {
+}
+
+SnapshotTree::~SnapshotTree() {
+    // The arenas own every node and course; only the Version records are separate.
+    for (auto& batch : retired)
+        delete batch.version;
+    delete current.load();
+}
+
+/*
+* acquireSlot: Claims a free reader slot, block by block. Starting from a per-thread position
+*              keeps concurrent readers on different cache lines. When every block is full a
+*              new one is linked with a CAS; a reader that loses the race frees its block and
+*              moves on to the winner's.
+*/
+SnapshotTree::ReaderSlot* SnapshotTree::acquireSlot() const {
+    std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % readerBlockSize;
+    ReaderBlock* block = readers.get();
+    for (;;) {
+        for (std::size_t i = 0; i < readerBlockSize; ++i) {
+            ReaderSlot& slot = block->slots[(start + i) % readerBlockSize];
+            bool expected = false;
+            if (!slot.inUse.load(std::memory_order_relaxed)
+                && slot.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return &slot;
+        }
+        ReaderBlock* next = block->next.load();
+        if (!next) {
+            ReaderBlock* grown = new ReaderBlock;
+            if (block->next.compare_exchange_strong(next, grown))
+                next = grown;
+            else
+                delete grown;
+        }
+        block = next;
+    }
+}
+
+/*
+* snapshot: Announces the current epoch, then loads the current version. Both are sequentially
+*           consistent, so a writer that frees a version after this announcement is visible
+*           either saw the announcement or published its replacement before our load.
+*/
+SnapshotTree::Snapshot SnapshotTree::snapshot() const {
+    ReaderSlot* slot = acquireSlot();
+    slot->epoch.store(globalEpoch.load());
+    return Snapshot(current.load(), slot);
+}
+
+SnapshotTree::Snapshot::~Snapshot() {
+    if (slot) {
+        slot->epoch.store(0);
+        slot->inUse.store(false, std::memory_order_release);
+    }
+}
+
+/*
+* Snapshot::search: Plain descent over immutable nodes.
+*/
+const Course* SnapshotTree::Snapshot::search(std::string_view courseNumber) const {
+    CourseKey key(courseNumber);
+    const SnapshotNode* node = version->root;
+    while (node) {
+        int cmp = compareCourseKeys(key, courseNumber, node->key, node->course->courseNumber);
+        if (cmp == 0)
+            return node->course;
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return nullptr;
+}
+
+/*
+* beginWrite: Starts a new write on top of the latest version.
+*/
+void SnapshotTree::beginWrite() {
+    const Version* latest = current.load();
+    root = const_cast<SnapshotNode*>(latest->root);
+    count = latest->size;
+    ++writeId;
+    pending.nodes.clear();
+    pending.courses.clear();
+}
+
+/*
+* publish: Swaps in the new version, retires what it replaced under the current epoch, then
+*          advances the epoch and frees whatever no reader can still reach.
+*/
+void SnapshotTree::publish() {
+    const Version* previous = current.exchange(new Version{ root, count });
+    pending.epoch = globalEpoch.load();
+    pending.version = previous;
+    retired.push_back(std::move(pending));
+    pending = RetiredBatch{ 0, nullptr, {}, {} };
+    globalEpoch.fetch_add(1);
+    reclaim();
+}
+
+/*
+* reclaim: A batch retired in epoch e is unreachable for every reader that announced an epoch
+*          after e, so it is freed once all active readers announced a later epoch. A block
+*          linked after the scan passed its predecessor only holds readers that announce
+*          after this scan, which load the version published before it.
+*/
+void SnapshotTree::reclaim() {
+    std::uint64_t oldestActive = std::numeric_limits<std::uint64_t>::max();
+    for (const ReaderBlock* block = readers.get(); block; block = block->next.load()) {
+        for (const ReaderSlot& slot : block->slots) {
+            std::uint64_t epoch = slot.epoch.load();
+            if (epoch != 0 && epoch < oldestActive)
+                oldestActive = epoch;
+        }
+    }
+    while (!retired.empty() && retired.front().epoch < oldestActive) {
+        RetiredBatch& batch = retired.front();
+        for (SnapshotNode* node : batch.nodes)
+            nodes.destroy(node);
+        for (const Course* course : batch.courses)
+            courses.destroy(const_cast<Course*>(course));
+        delete batch.version;
+        retired.pop_front();
+    }
+}
+
+/*
+* pendingReclaim: Number of retired objects not yet freed.
+*/
+std::size_t SnapshotTree::pendingReclaim() const {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    std::size_t total = 0;
+    for (const auto& batch : retired)
+        total += batch.nodes.size() + batch.courses.size() + 1;
+    return total;
+}
+
+/*
+* own: Copy-on-write. Nodes created by this write are modified in place; older nodes are
+*      copied, the copy is linked into slot, and the original is retired with this write.
+*      Every writable node's parent is writable too, so parent links stay usable while the
+*      write rebalances.
+*/
+SnapshotNode* SnapshotTree::own(SnapshotNode* parent, SnapshotNode*& slot) {
+    SnapshotNode* node = slot;
+    if (!node)
+        return nullptr;
+    if (node->version != writeId) {
+        SnapshotNode* copy = nodes.create(*node);
+        copy->version = writeId;
+        pending.nodes.push_back(node);
+        slot = copy;
+        node = copy;
+    }
+    node->parent = parent;
+    return node;
+}
+
+/*
+* leftRotate: Same rotation as RedBlackTree, except the subtree that changes parent is made
+*             writable first.
+*/
+void SnapshotTree::leftRotate(SnapshotNode* x) {
+    SnapshotNode* y = own(x, x->right);
+    if (!y) return;
+    x->right = y->left;
+    own(x, x->right);
+    y->parent = x->parent;
+    if (!x->parent)
+        root = y;
+    else if (x == x->parent->left)
+        x->parent->left = y;
+    else
+        x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+/*
+* rightRotate: Mirror of leftRotate.
+*/
+void SnapshotTree::rightRotate(SnapshotNode* x) {
+    SnapshotNode* y = own(x, x->left);
+    if (!y) return;
+    x->left = y->right;
+    own(x, x->left);
+    y->parent = x->parent;
+    if (!x->parent)
+        root = y;
+    else if (x == x->parent->right)
+        x->parent->right = y;
+    else
+        x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+/*
+* insertFixup: The RedBlackTree fixup; z, its parent and grandparent are on the copied path,
+*              and the uncle is copied before it is recolored.
+*/
+void SnapshotTree::insertFixup(SnapshotNode* z) {
+    while (z->parent && z->parent->color == RED) {
+        SnapshotNode* zParent = z->parent;
+        SnapshotNode* zGrandparent = zParent->parent;
+        if (zParent == zGrandparent->left) {
+            if (colorOf(zGrandparent->right) == RED) {
+                SnapshotNode* y = own(zGrandparent, zGrandparent->right);
+                zParent->color = BLACK;
+                y->color = BLACK;
+                zGrandparent->color = RED;
+                z = zGrandparent;
+            }
+            else {
+                if (z == zParent->right) {
+                    z = zParent;
+                    leftRotate(z);
+                    zParent = z->parent;
+                }
+                zParent->color = BLACK;
+                zGrandparent->color = RED;
+                rightRotate(zGrandparent);
+            }
+        }
+        else {
+            if (colorOf(zGrandparent->left) == RED) {
+                SnapshotNode* y = own(zGrandparent, zGrandparent->left);
+                zParent->color = BLACK;
+                y->color = BLACK;
+                zGrandparent->color = RED;
+                z = zGrandparent;
+            }
+            else {
+                if (z == zParent->left) {
+                    z = zParent;
+                    rightRotate(z);
+                    zParent = z->parent;
+                }
+                zParent->color = BLACK;
+                zGrandparent->color = RED;
+                leftRotate(zGrandparent);
+            }
+        }
+    }
+    root->color = BLACK;
+}
+
+/*
+* upsert: Copies the search path, then either swaps the course on the copied node or links a
+*         new red leaf and rebalances.
+*/
+void SnapshotTree::upsert(const Course& course) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    beginWrite();
+    CourseKey key(course.courseNumber);
+    SnapshotNode* parent = nullptr;
+    SnapshotNode** slot = &root;
+    while (*slot) {
+        SnapshotNode* node = own(parent, *slot);
+        int cmp = compareCourseKeys(key, course.courseNumber, node->key, node->course->courseNumber);
+        if (cmp == 0) {
+            pending.courses.push_back(node->course);
+            node->course = courses.create(course);
+            publish();
+            return;
+        }
+        parent = node;
+        slot = cmp < 0 ? &node->left : &node->right;
+    }
+    SnapshotNode* z = nodes.create(SnapshotNode{ key, nullptr, nullptr, parent, courses.create(course), writeId, RED });
+    *slot = z;
+    ++count;
+    insertFixup(z);
+    publish();
+}
+
+/*
+* transplant: Puts v (already writable, possibly null) where u was.
+*/
+void SnapshotTree::transplant(SnapshotNode* u, SnapshotNode* v) {
+    if (!u->parent)
+        root = v;
+    else if (u == u->parent->left)
+        u->parent->left = v;
+    else
+        u->parent->right = v;
+    if (v)
+        v->parent = u->parent;
+}
+
+/*
+* eraseFixup: The RedBlackTree delete fixup; the sibling and any of its children that get
+*             recolored are copied before they are touched.
+*/
+void SnapshotTree::eraseFixup(SnapshotNode* x, SnapshotNode* xParent) {
+    while (x != root && colorOf(x) == BLACK) {
+        if (x == xParent->left) {
+            SnapshotNode* w = own(xParent, xParent->right);
+            if (w->color == RED) {
+                w->color = BLACK;
+                xParent->color = RED;
+                leftRotate(xParent);
+                w = own(xParent, xParent->right);
+            }
+            if (colorOf(w->left) == BLACK && colorOf(w->right) == BLACK) {
+                w->color = RED;
+                x = xParent;
+                xParent = x->parent;
+            }
+            else {
+                if (colorOf(w->right) == BLACK) {
+                    own(w, w->left)->color = BLACK;
+                    w->color = RED;
+                    rightRotate(w);
+                    w = own(xParent, xParent->right);
+                }
+                w->color = xParent->color;
+                xParent->color = BLACK;
+                if (w->right)
+                    own(w, w->right)->color = BLACK;
+                leftRotate(xParent);
+                x = root;
+                xParent = nullptr;
+            }
+        }
+        else {
+            SnapshotNode* w = own(xParent, xParent->left);
+            if (w->color == RED) {
+                w->color = BLACK;
+                xParent->color = RED;
+                rightRotate(xParent);
+                w = own(xParent, xParent->left);
+            }
+            if (colorOf(w->right) == BLACK && colorOf(w->left) == BLACK) {
+                w->color = RED;
+                x = xParent;
+                xParent = x->parent;
+            }
+            else {
+                if (colorOf(w->left) == BLACK) {
+                    own(w, w->right)->color = BLACK;
+                    w->color = RED;
+                    leftRotate(w);
+                    w = own(xParent, xParent->left);
+                }
+                w->color = xParent->color;
+                xParent->color = BLACK;
+                if (w->left)
+                    own(w, w->left)->color = BLACK;
+                rightRotate(xParent);
+                x = root;
+                xParent = nullptr;
+            }
+        }
+    }
+    if (x)
+        x->color = BLACK;
+}
+
+/*
+* erase: Checks for the course without copying anything, then runs the standard delete on
+*        a copied path (down to the successor when the node has two children).
+*/
+bool SnapshotTree::erase(std::string_view courseNumber) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    CourseKey key(courseNumber);
+    const SnapshotNode* probe = current.load()->root;
+    while (probe) {
+        int cmp = compareCourseKeys(key, courseNumber, probe->key, probe->course->courseNumber);
+        if (cmp == 0)
+            break;
+        probe = cmp < 0 ? probe->left : probe->right;
+    }
+    if (!probe)
+        return false;
+
+    beginWrite();
+    SnapshotNode* parent = nullptr;
+    SnapshotNode** slot = &root;
+    SnapshotNode* z = nullptr;
+    for (;;) {
+        z = own(parent, *slot);
+        int cmp = compareCourseKeys(key, courseNumber, z->key, z->course->courseNumber);
+        if (cmp == 0)
+            break;
+        parent = z;
+        slot = cmp < 0 ? &z->left : &z->right;
+    }
+
+    Color removedColor = z->color;
+    SnapshotNode* x = nullptr;
+    SnapshotNode* xParent = nullptr;
+    if (!z->left) {
+        x = own(z, z->right);
+        xParent = z->parent;
+        transplant(z, x);
+    }
+    else if (!z->right) {
+        x = own(z, z->left);
+        xParent = z->parent;
+        transplant(z, x);
+    }
+    else {
+        SnapshotNode* y = own(z, z->right);
+        while (y->left)
+            y = own(y, y->left);
+        removedColor = y->color;
+        x = own(y, y->right);
+        if (y->parent == z) {
+            xParent = y;
+        }
+        else {
+            xParent = y->parent;
+            transplant(y, x);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        transplant(z, y);
+        y->left = own(z, z->left);
+        y->left->parent = y;
+        y->color = z->color;
+    }
+    if (removedColor == BLACK)
+        eraseFixup(x, xParent);
+
+    // z is a copy made by this write (its original is already retired), so it can go now.
+    pending.courses.push_back(z->course);
+    nodes.destroy(z);
+    --count;
+    publish();
+    return true;
+}
+
+/*
+* buildBalanced: Same O(n) construction as RedBlackTree::bulkLoad.
+*/
+SnapshotNode* SnapshotTree::buildBalanced(const std::vector<const Course*>& sorted, std::size_t lo, std::size_t hi,
+                                          std::size_t depth, std::size_t redDepth) {
+    if (lo >= hi)
+        return nullptr;
+    std::size_t mid = lo + (hi - lo) / 2;
+    SnapshotNode* node = nodes.create(SnapshotNode{ CourseKey(sorted[mid]->courseNumber), nullptr, nullptr, nullptr,
+                                                    sorted[mid], writeId, depth == redDepth ? RED : BLACK });
+    node->left = buildBalanced(sorted, lo, mid, depth + 1, redDepth);
+    node->right = buildBalanced(sorted, mid + 1, hi, depth + 1, redDepth);
+    return node;
+}
+
+/*
+* assign: Retires every node and course of the latest version and publishes a freshly built
+*         copy of the given tree.
+*/
+void SnapshotTree::assign(const RedBlackTree& tree) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    beginWrite();
+    std::vector<SnapshotNode*> stack;
+    if (root)
+        stack.push_back(root);
+    while (!stack.empty()) {
+        SnapshotNode* node = stack.back();
+        stack.pop_back();
+        pending.nodes.push_back(node);
+        pending.courses.push_back(node->course);
+        if (node->left)
+            stack.push_back(node->left);
+        if (node->right)
+            stack.push_back(node->right);
+    }
+
+    std::vector<const Course*> sorted;
+    sorted.reserve(tree.size());
+    tree.forEachInOrder([&](const Course& course) { sorted.push_back(courses.create(course)); });
+    std::size_t fullLevels = 0;
+    while ((std::size_t(2) << fullLevels) - 1 <= sorted.size())
+        ++fullLevels;
+    root = buildBalanced(sorted, 0, sorted.size(), 0, fullLevels);
+    if (root)
+        root->color = BLACK;
+    count = sorted.size();
+    publish();
+}
@@ -0,0 +1,182 @@
+/*
+    File: SnapshotTree.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: SnapshotTree, SnapshotNode
+    Description: Persistent (path-copying) Red-Black Tree with lock-free snapshot readers
+*/
+#ifndef SNAPSHOT_TREE_H
+#define SNAPSHOT_TREE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Course.h"
+
+/*
+* Structure: SnapshotNode
+* Description: Node of a SnapshotTree. Once a version is published its nodes never change;
+*              a writer that needs to modify one copies it first. The course is shared
+*              between copies. parent is only meaningful inside the write that created the
+*              node and must not be used by readers.
+*/
+struct SnapshotNode {
+    CourseKey key;
+    SnapshotNode* left;
+    SnapshotNode* right;
+    SnapshotNode* parent;
+    const Course* course;
+    std::uint64_t version;   // write that created this node
+    Color color;
+};
+
+/*
+* Class: SnapshotTree
+* Description: Course catalog for many concurrent readers and one writer at a time. Every
+*              write copies the nodes it touches (path copying), rebalances the copies with
+*              the usual Red-Black fixups, and publishes the new root with one atomic store.
+*              Readers take a Snapshot, which pins the version they saw and runs search and
+*              traversal without any locks. Replaced nodes are reclaimed with epoch-based
+*              reclamation once no reader pinned before the replacement is still active.
+*/
+class SnapshotTree {
+private:
+    // Root and size of one published version.
+    struct Version {
+        const SnapshotNode* root;
+        std::size_t size;
+    };
+
+    // Per-reader announcement of the epoch it started in (0 = idle), on its own cache line.
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{ 0 };
+        std::atomic<bool> inUse{ false };
+    };
+
+    static constexpr std::size_t readerBlockSize = 64;
+
+    // Fixed block of reader slots. A reader that finds every slot taken links a new block
+    // after the last one; blocks are only freed with the tree.
+    struct ReaderBlock {
+        ReaderSlot slots[readerBlockSize];
+        std::atomic<ReaderBlock*> next{ nullptr };
+        ~ReaderBlock() { delete next.load(); }
+    };
+
+    // Everything replaced by one write, freed once every reader has moved past its epoch.
+    struct RetiredBatch {
+        std::uint64_t epoch;
+        const Version* version;
+        std::vector<SnapshotNode*> nodes;
+        std::vector<const Course*> courses;
+    };
+
+    std::atomic<const Version*> current;
+    std::atomic<std::uint64_t> globalEpoch;
+    std::unique_ptr<ReaderBlock> readers;
+
+    // Writer-only state, guarded by writerMutex.
+    mutable std::mutex writerMutex;
+    NodeArena<SnapshotNode> nodes;
+    NodeArena<Course> courses;
+    std::deque<RetiredBatch> retired;
+    SnapshotNode* root;          // working root of the write in progress
+    std::size_t count;           // working size of the write in progress
+    std::uint64_t writeId;       // id stamped on nodes created by the write in progress
+    RetiredBatch pending;        // nodes and courses replaced by the write in progress
+
+    void beginWrite();
+    void publish();
+    void reclaim();
+
+    // Makes the node in slot (a child link of parent, or root) writable by this write,
+    // copying it if an older version owns it, and returns it.
+    SnapshotNode* own(SnapshotNode* parent, SnapshotNode*& slot);
+
+    void leftRotate(SnapshotNode* x);
+    void rightRotate(SnapshotNode* x);
+    void insertFixup(SnapshotNode* z);
+    void transplant(SnapshotNode* u, SnapshotNode* v);
+    void eraseFixup(SnapshotNode* x, SnapshotNode* xParent);
+    SnapshotNode* buildBalanced(const std::vector<const Course*>& sorted, std::size_t lo, std::size_t hi,
+                                std::size_t depth, std::size_t redDepth);
+
+    ReaderSlot* acquireSlot() const;
+
+public:
+    /*
+    * Class: Snapshot
+    * Description: Read handle on one published version. Courses returned by search stay
+    *              valid for as long as the snapshot is alive, whatever writers do meanwhile.
+    */
+    class Snapshot {
+    private:
+        const Version* version;
+        ReaderSlot* slot;
+
+        Snapshot(const Version* version, ReaderSlot* slot) : version(version), slot(slot) {}
+        friend class SnapshotTree;
+
+    public:
+        Snapshot(Snapshot&& other) noexcept : version(other.version), slot(other.slot) {
+            other.slot = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot();
+
+        // Finds a course by number; null if it is not in this version.
+        const Course* search(std::string_view courseNumber) const;
+
+        // Number of courses in this version.
+        std::size_t size() const { return version->size; }
+
+        // Calls visit(const Course&) for every course in this version, in course-number order.
+        template <typename Visitor>
+        void forEachInOrder(Visitor&& visit) const {
+            const SnapshotNode* stack[128];  // Red-Black height is at most 2 log2(n + 1)
+            std::size_t depth = 0;
+            const SnapshotNode* node = version->root;
+            while (node || depth) {
+                while (node) {
+                    stack[depth++] = node;
+                    node = node->left;
+                }
+                node = stack[--depth];
+                visit(*node->course);
+                node = node->right;
+            }
+        }
+    };
+
+    SnapshotTree();
+    ~SnapshotTree();  // No snapshot may outlive the tree
+
+    SnapshotTree(const SnapshotTree&) = delete;
+    SnapshotTree& operator=(const SnapshotTree&) = delete;
+
+    // Pins the latest published version. Lock-free; never blocks on writers. There is no limit
+    // on live snapshots: each time readerBlockSize more are alive at once another block of
+    // reader slots is allocated, and it is kept until the tree is destroyed.
+    Snapshot snapshot() const;
+
+    // Inserts the course, or replaces the one with the same number, and publishes the result.
+    void upsert(const Course& course);
+
+    // Removes a course and publishes the result. Returns false if it was not present.
+    bool erase(std::string_view courseNumber);
+
+    // Replaces the whole catalog with the contents of tree (built in O(n)) and publishes it.
+    void assign(const RedBlackTree& tree);
+
+    // Versions, nodes and courses waiting for readers to move on before being freed.
+    std::size_t pendingReclaim() const;
+};
+
+#endif
@@ -0,0 +1,638 @@
+/*
+    File: TitleIndex.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Builds, maintains and queries the course title inverted index
+*/
+
+#include "TitleIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+    // Standard BM25 parameters: term-frequency saturation and title-length normalization.
+    constexpr double k1 = 1.2;
+    constexpr double b = 0.75;
+
+    // Score multipliers for fuzzy matches relative to an exact word match.
+    constexpr double containsWeight = 0.8;
+    constexpr double typoWeight = 0.9;      // minus typoPenalty per edit
+    constexpr double typoPenalty = 0.2;
+
+    // fuzzySearch ranks each combination of word expansions separately up to this many.
+    constexpr std::size_t maximumPicks = 32;
+
+    // Tombstones are only compacted away once there are at least this many.
+    constexpr std::size_t minimumCompaction = 1024;
+
+    // Packs three bytes into a trigram key; 0 marks the start or end of a word.
+    std::uint32_t trigram(unsigned char a, unsigned char c1, unsigned char c2) {
+        return (std::uint32_t(a) << 16) | (std::uint32_t(c1) << 8) | c2;
+    }
+
+    // Distinct trigrams of a word padded with a boundary marker on each side.
+    void trigramsOf(const std::string& word, std::vector<std::uint32_t>& grams) {
+        grams.clear();
+        std::string padded;
+        padded.reserve(word.size() + 2);
+        padded += '\0';
+        padded += word;
+        padded += '\0';
+        for (std::size_t i = 0; i + 2 < padded.size(); ++i)
+            grams.push_back(trigram(static_cast<unsigned char>(padded[i]), static_cast<unsigned char>(padded[i + 1]),
+                                    static_cast<unsigned char>(padded[i + 2])));
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    }
+
+    // A trigram made only of word characters (no boundary marker).
+    bool isInterior(std::uint32_t gram) {
+        return (gram >> 16) != 0 && ((gram >> 8) & 0xFF) != 0 && (gram & 0xFF) != 0;
+    }
+
+    // Optimal string alignment distance (adjacent swaps count as one edit), or limit + 1
+    // as soon as the distance is known to exceed limit. rows is scratch space.
+    unsigned editDistance(const std::string& a, const std::string& c, unsigned limit, std::vector<unsigned>& rows) {
+        std::size_t n = a.size(), m = c.size();
+        if ((n > m ? n - m : m - n) > limit)
+            return limit + 1;
+        rows.resize(3 * (m + 1));
+        unsigned* before = rows.data();
+        unsigned* previous = before + m + 1;
+        unsigned* current = previous + m + 1;
+        for (std::size_t j = 0; j <= m; ++j)
+            previous[j] = static_cast<unsigned>(j);
+        for (std::size_t i = 1; i <= n; ++i) {
+            current[0] = static_cast<unsigned>(i);
+            unsigned rowMinimum = current[0];
+            for (std::size_t j = 1; j <= m; ++j) {
+                unsigned cost = a[i - 1] == c[j - 1] ? 0 : 1;
+                current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost });
+                if (i > 1 && j > 1 && a[i - 1] == c[j - 2] && a[i - 2] == c[j - 1])
+                    current[j] = std::min(current[j], before[j - 2] + 1);
+                rowMinimum = std::min(rowMinimum, current[j]);
+            }
+            if (rowMinimum > limit)
+                return limit + 1;
+            std::swap(before, previous);
+            std::swap(previous, current);
+        }
+        return previous[m];
+    }
+
+    // BM25 weight of one posting given the term's idf.
+    double bm25(double idf, unsigned frequency, unsigned length, double averageLength) {
+        double tf = static_cast<double>(frequency);
+        return idf * tf * (k1 + 1.0) / (tf + k1 * (1.0 - b + b * static_cast<double>(length) / averageLength));
+    }
+
+    // First position at or after from whose value is not less than target: gallops forward
+    // in doubling steps, then binary-searches the last step, so walking a long list in step
+    // with a short one costs O(short * log(long / short)).
+    std::size_t gallop(const std::vector<std::uint32_t>& list, std::size_t from, std::uint32_t target) {
+        std::size_t step = 1;
+        std::size_t high = from;
+        while (high < list.size() && list[high] < target) {
+            from = high + 1;
+            high += step;
+            step *= 2;
+        }
+        high = std::min(high, list.size());
+        return static_cast<std::size_t>(std::lower_bound(list.begin() + static_cast<std::ptrdiff_t>(from),
+                                                         list.begin() + static_cast<std::ptrdiff_t>(high), target) - list.begin());
+    }
+
+    /*
+    * Class: TopMatches
+    * Description: Keeps the best limit matches seen so far in a heap whose front is the worst
+    *              of them. Ties go to the lower document ID (index order, which is course-number
+    *              order after a bulk load), so a document offered after the heap fills needs a
+    *              strictly higher score than threshold() to get in.
+    */
+    class TopMatches {
+    private:
+        struct Candidate {
+            double score;
+            std::uint32_t id;
+        };
+        std::size_t limit;
+        std::vector<Candidate> heap;
+
+        static bool better(const Candidate& x, const Candidate& y) {
+            if (x.score != y.score)
+                return x.score > y.score;
+            return x.id < y.id;
+        }
+
+    public:
+        explicit TopMatches(std::size_t limit) : limit(limit) { heap.reserve(limit); }
+
+        bool full() const { return heap.size() == limit; }
+
+        // Score of the worst kept match; only meaningful once full().
+        double threshold() const { return heap.front().score; }
+
+        void offer(std::uint32_t id, double score) {
+            Candidate candidate{ score, id };
+            if (heap.size() < limit) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+            else if (better(candidate, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+
+        // The kept matches, best first.
+        std::vector<TitleMatch> take(const std::vector<const Course*>& documents) {
+            std::sort_heap(heap.begin(), heap.end(), better);
+            std::vector<TitleMatch> matches;
+            matches.reserve(heap.size());
+            for (const Candidate& candidate : heap)
+                matches.push_back({ documents[candidate.id], candidate.score });
+            return matches;
+        }
+    };
+
+    // Keeps the best score per document from hits sorted by document ID then score.
+    void keepBestPerDocument(std::vector<std::pair<std::uint32_t, double>>& hits) {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            if (i + 1 == hits.size() || hits[i + 1].first != hits[i].first)
+                hits[kept++] = hits[i];
+        hits.resize(kept);
+    }
+
+    // Sorted, de-duplicated query words.
+    std::vector<std::string> queryWords(std::string_view query) {
+        std::vector<std::string> words;
+        TitleIndex::tokenize(query, words);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+}
+
+TitleIndex::TitleIndex(bool trigrams) : useTrigrams(trigrams) {}
+
+void TitleIndex::Term::append(std::uint32_t id, std::uint16_t frequency, std::uint16_t length) {
+    if (documents.size() % blockSize == 0) {
+        blockMaxFrequency.push_back(frequency);
+        blockMinLength.push_back(length);
+    }
+    else {
+        blockMaxFrequency.back() = std::max(blockMaxFrequency.back(), frequency);
+        blockMinLength.back() = std::min(blockMinLength.back(), length);
+    }
+    documents.push_back(id);
+    frequencies.push_back(frequency);
+    lengths.push_back(length);
+    maxFrequency = std::max(maxFrequency, frequency);
+    minLength = std::min(minLength, length);
+}
+
+/*
+* tokenize: Lowercases ASCII letters as it goes; every other byte outside [A-Za-z0-9] and the
+*           UTF-8 range ends the current word.
+*/
+void TitleIndex::tokenize(std::string_view text, std::vector<std::string>& words) {
+    words.clear();
+    std::string* word = nullptr;
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        bool wordByte = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+        if (!wordByte) {
+            word = nullptr;
+            continue;
+        }
+        if (!word) {
+            words.emplace_back();
+            word = &words.back();
+        }
+        *word += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : ch;
+    }
+}
+
+/*
+* courseAdded: Gives the course the next document ID and appends one posting per distinct title
+*              word. IDs only grow, so every posting list stays sorted without any insertion.
+*/
+void TitleIndex::courseAdded(const Course& course) {
+    std::uint32_t id = static_cast<std::uint32_t>(documents.size());
+    documents.push_back(&course);
+    documentIds[&course] = id;
+
+    tokenize(course.courseTitle, scratch);
+    std::uint16_t length = static_cast<std::uint16_t>(std::min<std::size_t>(scratch.size(), UINT16_MAX));
+    lengths.push_back(length);
+    if (id % 64 == 0)
+        removed.push_back(0);
+    totalLength += length;
+    ++liveDocuments;
+
+    std::sort(scratch.begin(), scratch.end());
+    std::vector<std::uint32_t> grams;
+    for (std::size_t i = 0; i < scratch.size();) {
+        std::size_t run = i + 1;
+        while (run < scratch.size() && scratch[run] == scratch[i])
+            ++run;
+
+        auto found = termIds.find(scratch[i]);
+        std::uint32_t termId;
+        if (found != termIds.end()) {
+            termId = found->second;
+        }
+        else {
+            termId = static_cast<std::uint32_t>(terms.size());
+            terms.emplace_back();
+            terms.back().text = scratch[i];
+            termIds.emplace(terms.back().text, termId);
+            if (useTrigrams) {
+                trigramsOf(terms.back().text, grams);
+                for (std::uint32_t gram : grams)
+                    trigramTerms[gram].push_back(termId);
+            }
+        }
+        Term& term = terms[termId];
+        term.append(id, static_cast<std::uint16_t>(std::min<std::size_t>(run - i, UINT16_MAX)), length);
+        ++term.liveDocuments;
+        i = run;
+    }
+}
+
+/*
+* courseRemoved: Tombstones the document. The title is still intact, so its words tell us which
+*                terms lose a live document; the postings themselves are dropped by compact().
+*/
+void TitleIndex::courseRemoved(const Course& course) {
+    auto found = documentIds.find(&course);
+    if (found == documentIds.end())
+        return;
+    std::uint32_t id = found->second;
+    documentIds.erase(found);
+
+    tokenize(course.courseTitle, scratch);
+    std::sort(scratch.begin(), scratch.end());
+    scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+    for (const auto& word : scratch) {
+        auto term = termIds.find(word);
+        if (term != termIds.end())
+            --terms[term->second].liveDocuments;
+    }
+
+    documents[id] = nullptr;
+    removed[id / 64] |= std::uint64_t(1) << (id % 64);
+    totalLength -= lengths[id];
+    --liveDocuments;
+    ++deadDocuments;
+    if (deadDocuments >= minimumCompaction && deadDocuments > liveDocuments)
+        compact();
+}
+
+/*
+* cleared: Drops everything, vocabulary included.
+*/
+void TitleIndex::cleared() {
+    terms.clear();
+    termIds.clear();
+    trigramTerms.clear();
+    documents.clear();
+    lengths.clear();
+    removed.clear();
+    documentIds.clear();
+    liveDocuments = 0;
+    deadDocuments = 0;
+    totalLength = 0;
+}
+
+/*
+* compact: Live documents keep their relative order, so renumbered posting lists stay sorted.
+*          The lists are rebuilt through Term::append, which also tightens the score bounds.
+*/
+void TitleIndex::compact() {
+    std::vector<std::uint32_t> renumbered(documents.size(), UINT32_MAX);
+    std::uint32_t next = 0;
+    for (std::size_t id = 0; id < documents.size(); ++id) {
+        if (!documents[id])
+            continue;
+        renumbered[id] = next;
+        documents[next] = documents[id];
+        lengths[next] = lengths[id];
+        ++next;
+    }
+    documents.resize(next);
+    lengths.resize(next);
+    removed.assign((next + 63) / 64, 0);
+
+    for (Term& term : terms) {
+        Term rebuilt;
+        rebuilt.liveDocuments = term.liveDocuments;
+        rebuilt.documents.reserve(term.liveDocuments);
+        rebuilt.frequencies.reserve(term.liveDocuments);
+        for (std::size_t i = 0; i < term.documents.size(); ++i) {
+            std::uint32_t id = renumbered[term.documents[i]];
+            if (id != UINT32_MAX)
+                rebuilt.append(id, term.frequencies[i], term.lengths[i]);
+        }
+        term.documents = std::move(rebuilt.documents);
+        term.frequencies = std::move(rebuilt.frequencies);
+        term.lengths = std::move(rebuilt.lengths);
+        term.blockMaxFrequency = std::move(rebuilt.blockMaxFrequency);
+        term.blockMinLength = std::move(rebuilt.blockMinLength);
+        term.maxFrequency = rebuilt.maxFrequency;
+        term.minLength = rebuilt.minLength;
+    }
+    for (auto& entry : documentIds)
+        entry.second = renumbered[entry.second];
+    deadDocuments = 0;
+}
+
+double TitleIndex::idf(const Term& term) const {
+    double n = static_cast<double>(liveDocuments);
+    double df = static_cast<double>(term.liveDocuments);
+    return std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+}
+
+/*
+* rankIntersection: Walks the shortest posting list block by block and gallops through the
+*                   others in step with it, so the cost follows the rarest list rather than the
+*                   catalog size. For each block the other lists' postings in the same ID range
+*                   give an upper bound on what any document in it can score; once limit
+*                   matches are held, blocks (and then single documents) whose bound cannot beat
+*                   the worst of them are skipped. Bounds are summed in the same order as real
+*                   scores, so rounding never lets a skipped document outscore its bound.
+*/
+std::vector<TitleMatch> TitleIndex::rankIntersection(std::vector<Expansion> lists, std::size_t limit) const {
+    std::sort(lists.begin(), lists.end(), [](const Expansion& x, const Expansion& y) {
+        return x.term->documents.size() < y.term->documents.size();
+    });
+    double averageLength = static_cast<double>(totalLength) / static_cast<double>(liveDocuments);
+    auto score = [&](const Expansion& list, unsigned frequency, unsigned length) {
+        return list.weight * bm25(list.idf, frequency, length, averageLength);
+    };
+
+    std::vector<double> otherBounds(lists.size(), 0.0);    // per block, for lists[1..]
+    auto bound = [&](double leadScore) {
+        for (std::size_t k = 1; k < lists.size(); ++k)
+            leadScore += otherBounds[k];
+        return leadScore;
+    };
+
+    TopMatches top(limit);
+    std::vector<std::size_t> cursors(lists.size(), 0);
+    const Term& lead = *lists[0].term;
+    for (std::size_t block = 0; block * blockSize < lead.documents.size(); ++block) {
+        std::size_t blockStart = block * blockSize;
+        std::size_t blockEnd = std::min(lead.documents.size(), blockStart + blockSize);
+        std::uint32_t firstId = lead.documents[blockStart];
+        std::uint32_t lastId = lead.documents[blockEnd - 1];
+
+        bool possible = true;
+        for (std::size_t k = 1; k < lists.size() && possible; ++k) {
+            const Term& other = *lists[k].term;
+            cursors[k] = gallop(other.documents, cursors[k], firstId);
+            if (cursors[k] == other.documents.size())
+                return top.take(documents);  // A longer list ran out; nothing later can match
+            std::size_t rangeEnd = gallop(other.documents, cursors[k], lastId + 1);
+            possible = rangeEnd > cursors[k];
+            otherBounds[k] = 0.0;
+            for (std::size_t b = cursors[k] / blockSize; possible && b <= (rangeEnd - 1) / blockSize; ++b)
+                otherBounds[k] = std::max(otherBounds[k], score(lists[k], other.blockMaxFrequency[b], other.blockMinLength[b]));
+        }
+        if (!possible)
+            continue;
+        if (top.full() && bound(score(lists[0], lead.blockMaxFrequency[block], lead.blockMinLength[block])) <= top.threshold())
+            continue;
+
+        for (std::size_t i = blockStart; i < blockEnd; ++i) {
+            std::uint32_t id = lead.documents[i];
+            if (isRemoved(id))
+                continue;
+            double total = score(lists[0], lead.frequencies[i], lead.lengths[i]);
+            if (top.full() && bound(total) <= top.threshold())
+                continue;
+            bool matched = true;
+            for (std::size_t k = 1; k < lists.size(); ++k) {
+                const Term& other = *lists[k].term;
+                std::size_t& cursor = cursors[k];
+                cursor = gallop(other.documents, cursor, id);
+                if (cursor == other.documents.size() || other.documents[cursor] != id) {
+                    matched = false;
+                    break;
+                }
+                total += score(lists[k], other.frequencies[cursor], other.lengths[cursor]);
+            }
+            if (matched)
+                top.offer(id, total);
+        }
+    }
+    return top.take(documents);
+}
+
+/*
+* search: Every query word must be in the vocabulary; the ranked intersection does the rest.
+*/
+std::vector<TitleMatch> TitleIndex::search(std::string_view query, std::size_t limit) const {
+    std::vector<std::string> words = queryWords(query);
+    if (words.empty() || limit == 0 || liveDocuments == 0)
+        return {};
+
+    std::vector<Expansion> lists;
+    for (const auto& word : words) {
+        auto found = termIds.find(word);
+        if (found == termIds.end() || terms[found->second].liveDocuments == 0)
+            return {};
+        const Term& term = terms[found->second];
+        lists.push_back({ &term, 1.0, idf(term) });
+    }
+    return rankIntersection(std::move(lists), limit);
+}
+
+/*
+* expand: With trigrams, only vocabulary words sharing enough grams with the query word are
+*         checked: a substring match contains all of its interior grams, and each typo destroys
+*         at most three grams. Without trigrams the whole vocabulary is checked.
+*/
+std::vector<TitleIndex::Expansion> TitleIndex::expand(const std::string& word, unsigned maxEdits) const {
+    std::vector<Expansion> expansions;
+    std::vector<unsigned> rows;
+    auto consider = [&](const Term& term, std::size_t sharedGrams, std::size_t sharedInterior,
+                        std::size_t grams, std::size_t interiorGrams) {
+        if (term.liveDocuments == 0)
+            return;
+        if (term.text == word) {
+            expansions.push_back({ &term, 1.0, idf(term) });
+            return;
+        }
+        if (word.size() >= 3 && sharedInterior == interiorGrams && term.text.find(word) != std::string::npos) {
+            expansions.push_back({ &term, containsWeight, idf(term) });
+            return;
+        }
+        if (maxEdits == 0 || sharedGrams + 3 * std::size_t(maxEdits) < grams)
+            return;
+        unsigned distance = editDistance(word, term.text, maxEdits, rows);
+        if (distance <= maxEdits)
+            expansions.push_back({ &term, typoWeight - typoPenalty * distance, idf(term) });
+    };
+
+    std::vector<std::uint32_t> grams;
+    trigramsOf(word, grams);
+    std::size_t interiorGrams = static_cast<std::size_t>(std::count_if(grams.begin(), grams.end(), isInterior));
+
+    if (!useTrigrams) {
+        for (const Term& term : terms)
+            consider(term, grams.size(), interiorGrams, grams.size(), interiorGrams);
+        return expansions;
+    }
+
+    // Shared gram counts per candidate term: all grams, and interior grams only.
+    std::unordered_map<std::uint32_t, std::pair<std::size_t, std::size_t>> shared;
+    for (std::uint32_t gram : grams) {
+        auto found = trigramTerms.find(gram);
+        if (found == trigramTerms.end())
+            continue;
+        bool interior = isInterior(gram);
+        for (std::uint32_t termId : found->second) {
+            auto& counts = shared[termId];
+            ++counts.first;
+            if (interior)
+                ++counts.second;
+        }
+    }
+    for (const auto& [termId, counts] : shared)
+        consider(terms[termId], counts.first, counts.second, grams.size(), interiorGrams);
+    return expansions;
+}
+
+/*
+* fuzzySearch: A query word matches a course through any of its expansions, keeping the best
+*              weighted score, so a course's score is the sum over words of its best expansion.
+*              That equals the best score over every way of picking one expansion per word, and
+*              a course in the overall top limit is in the top limit of the pick that scores it
+*              best. So while there are few picks, each gets a pruned rankIntersection and the
+*              results are merged. Otherwise each word's postings are gathered into document
+*              order and intersected, starting from the word with the fewest postings.
+*/
+std::vector<TitleMatch> TitleIndex::fuzzySearch(std::string_view query, std::size_t limit, unsigned maxEdits) const {
+    std::vector<std::string> words = queryWords(query);
+    if (words.empty() || limit == 0 || liveDocuments == 0)
+        return {};
+
+    std::vector<std::pair<std::size_t, std::vector<Expansion>>> expanded;  // (postings, expansions)
+    std::size_t picks = 1;
+    for (const auto& word : words) {
+        unsigned allowed = word.size() < 4 ? 0u : word.size() < 8 ? 1u : 2u;
+        std::vector<Expansion> expansions = expand(word, std::min(allowed, maxEdits));
+        if (expansions.empty())
+            return {};
+        std::sort(expansions.begin(), expansions.end(), [](const Expansion& x, const Expansion& y) {
+            return x.term->documents.size() < y.term->documents.size();
+        });
+        std::size_t postings = 0;
+        for (const Expansion& expansion : expansions)
+            postings += expansion.term->documents.size();
+        picks = std::min(picks * expansions.size(), maximumPicks + 1);
+        expanded.emplace_back(postings, std::move(expansions));
+    }
+
+    TopMatches top(limit);
+    if (picks <= maximumPicks) {
+        // Odometer over one expansion per word; a course keeps its best pick's score.
+        std::unordered_map<const Course*, double> best;
+        std::vector<std::size_t> choice(expanded.size(), 0);
+        std::vector<Expansion> lists(expanded.size());
+        for (bool more = true; more;) {
+            for (std::size_t w = 0; w < expanded.size(); ++w)
+                lists[w] = expanded[w].second[choice[w]];
+            for (const TitleMatch& match : rankIntersection(lists, limit)) {
+                double& score = best[match.course];
+                score = std::max(score, match.score);
+            }
+            more = false;
+            for (std::size_t w = 0; w < expanded.size() && !more; ++w) {
+                if (++choice[w] < expanded[w].second.size())
+                    more = true;
+                else
+                    choice[w] = 0;
+            }
+        }
+        for (const auto& [course, score] : best)
+            top.offer(documentIds.at(course), score);
+        return top.take(documents);
+    }
+
+    std::sort(expanded.begin(), expanded.end(),
+              [](const auto& x, const auto& y) { return x.first < y.first; });
+    double averageLength = static_cast<double>(totalLength) / static_cast<double>(liveDocuments);
+
+    // Union of the expansions' live postings in document order, best score per document. Each
+    // list is already sorted, so a few lists (shortest first) are merged one at a time; many
+    // are sorted together.
+    auto gather = [&](std::size_t postings, const std::vector<Expansion>& expansions) {
+        std::vector<std::pair<std::uint32_t, double>> hits, run, merged;
+        hits.reserve(postings);
+        bool sortAtEnd = expansions.size() > 8;
+        for (const Expansion& expansion : expansions) {
+            const Term& term = *expansion.term;
+            std::vector<std::pair<std::uint32_t, double>>& target = sortAtEnd || hits.empty() ? hits : run;
+            for (std::size_t i = 0; i < term.documents.size(); ++i) {
+                std::uint32_t id = term.documents[i];
+                if (!isRemoved(id))
+                    target.push_back({ id, expansion.weight * bm25(expansion.idf, term.frequencies[i], term.lengths[i], averageLength) });
+            }
+            if (&target == &run) {
+                merged.resize(hits.size() + run.size());
+                std::merge(hits.begin(), hits.end(), run.begin(), run.end(), merged.begin());
+                hits.swap(merged);
+                run.clear();
+            }
+        }
+        if (sortAtEnd)
+            std::sort(hits.begin(), hits.end());
+        keepBestPerDocument(hits);
+        return hits;
+    };
+
+    std::vector<std::pair<std::uint32_t, double>> combined = gather(expanded[0].first, expanded[0].second);
+    for (std::size_t w = 1; w < expanded.size() && !combined.empty(); ++w) {
+        const auto& [postings, expansions] = expanded[w];
+        std::size_t out = 0;
+        if (combined.size() < postings) {
+            std::vector<std::size_t> cursors(expansions.size(), 0);
+            for (const auto& [id, score] : combined) {
+                double best = -1.0;
+                for (std::size_t e = 0; e < expansions.size(); ++e) {
+                    const Term& term = *expansions[e].term;
+                    cursors[e] = gallop(term.documents, cursors[e], id);
+                    if (cursors[e] < term.documents.size() && term.documents[cursors[e]] == id)
+                        best = std::max(best, expansions[e].weight * bm25(expansions[e].idf, term.frequencies[cursors[e]], term.lengths[cursors[e]], averageLength));
+                }
+                if (best >= 0.0)
+                    combined[out++] = { id, score + best };
+            }
+        }
+        else {
+            std::vector<std::pair<std::uint32_t, double>> hits = gather(postings, expansions);
+            std::size_t j = 0;
+            for (std::size_t i = 0; i < combined.size() && j < hits.size();) {
+                if (combined[i].first < hits[j].first)
+                    ++i;
+                else if (hits[j].first < combined[i].first)
+                    ++j;
+                else {
+                    combined[out++] = { combined[i].first, combined[i].second + hits[j].second };
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+        combined.resize(out);
+    }
+
+    for (const auto& [id, total] : combined)
+        top.offer(id, total);
+    return top.take(documents);
+}
@@ -0,0 +1,126 @@
+/*
+    File: TitleIndex.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: TitleIndex, TitleMatch
+    Description: Inverted index over course titles with ranked keyword search and optional
+                 trigram-based substring / typo-tolerant matching
+*/
+#ifndef TITLE_INDEX_H
+#define TITLE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Course.h"
+
+// One ranked search result. The course lives in the tree the index is attached to.
+struct TitleMatch {
+    const Course* course;
+    double score;           // BM25; higher is better
+};
+
+/*
+* Class: TitleIndex
+* Description: Maps every lowercase title word to a posting list of document IDs so keyword
+*              queries touch only the courses that contain the words, instead of scanning the
+*              whole catalog. Attach it with RedBlackTree::addObserver and the tree keeps it
+*              in sync on load, insert, upsert, erase and reload. Removed documents are
+*              tombstoned and the posting lists are compacted once tombstones outnumber live
+*              documents. With trigrams enabled, every vocabulary word is also indexed by its
+*              three-letter grams, which fuzzySearch uses to find substring and misspelled
+*              matches without scanning the vocabulary.
+*/
+class TitleIndex : public CourseObserver {
+public:
+    explicit TitleIndex(bool trigrams = true);
+
+    // The vocabulary map holds views into the terms, so the index is not copied.
+    TitleIndex(const TitleIndex&) = delete;
+    TitleIndex& operator=(const TitleIndex&) = delete;
+
+    // CourseObserver: called by the tree as courses are stored, removed and cleared.
+    void courseAdded(const Course& course) override;
+    void courseRemoved(const Course& course) override;
+    void cleared() override;
+
+    // Courses whose titles contain every word of query, best score first, at most limit.
+    std::vector<TitleMatch> search(std::string_view query, std::size_t limit = 10) const;
+
+    // Like search, but a query word also matches title words that contain it (words of three
+    // or more letters) or are a few typos away: none below four letters, one below eight,
+    // otherwise two, and never more than maxEdits. Closer matches score higher.
+    std::vector<TitleMatch> fuzzySearch(std::string_view query, std::size_t limit = 10, unsigned maxEdits = 2) const;
+
+    // Splits text into lowercase words: runs of ASCII letters and digits (bytes above 0x7F,
+    // such as UTF-8 sequences, count as letters).
+    static void tokenize(std::string_view text, std::vector<std::string>& words);
+
+    // Number of indexed (live) courses.
+    std::size_t size() const { return liveDocuments; }
+
+    // Number of distinct title words seen since the last clear.
+    std::size_t vocabularySize() const { return terms.size(); }
+
+    bool hasTrigrams() const { return useTrigrams; }
+
+private:
+    // Postings per block of score bounds; search skips whole blocks that cannot reach the top.
+    static constexpr std::size_t blockSize = 128;
+
+    struct Term {
+        std::string text;
+        std::vector<std::uint32_t> documents;       // ascending document IDs, tombstones included
+        std::vector<std::uint16_t> frequencies;     // occurrences in each document's title
+        std::vector<std::uint16_t> lengths;         // each document's title word count, kept
+                                                    // here so scoring reads memory in order
+        std::vector<std::uint16_t> blockMaxFrequency;   // per block: highest frequency
+        std::vector<std::uint16_t> blockMinLength;      // per block: shortest title
+        std::uint16_t maxFrequency = 0;             // over every posting
+        std::uint16_t minLength = UINT16_MAX;
+        std::uint32_t liveDocuments = 0;            // postings whose document is still live
+
+        // Appends a posting and widens the bounds to cover it.
+        void append(std::uint32_t id, std::uint16_t frequency, std::uint16_t length);
+    };
+
+    // A vocabulary word chosen for one query word, with the weight its score is scaled by.
+    struct Expansion {
+        const Term* term;
+        double weight;
+        double idf;
+    };
+
+    bool useTrigrams;
+    std::deque<Term> terms;                                     // term ID -> term (stable addresses)
+    std::unordered_map<std::string_view, std::uint32_t> termIds;   // views into Term::text
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> trigramTerms;  // gram -> term IDs
+    std::vector<const Course*> documents;                       // document ID -> course, null when removed
+    std::vector<std::uint16_t> lengths;                         // document ID -> title word count
+    std::vector<std::uint64_t> removed;                         // document ID -> tombstone bit
+    std::unordered_map<const Course*, std::uint32_t> documentIds;
+    std::size_t liveDocuments = 0;
+    std::size_t deadDocuments = 0;
+    std::uint64_t totalLength = 0;                              // title words over live documents
+    std::vector<std::string> scratch;                           // reused by courseAdded/courseRemoved
+
+    bool isRemoved(std::uint32_t id) const { return (removed[id / 64] >> (id % 64)) & 1; }
+
+    // BM25 inverse document frequency of a term over the live documents.
+    double idf(const Term& term) const;
+
+    // Best limit courses containing every list's term, by the sum of their weighted scores.
+    std::vector<TitleMatch> rankIntersection(std::vector<Expansion> lists, std::size_t limit) const;
+
+    // Vocabulary words that match word exactly, as a substring, or within maxEdits typos.
+    std::vector<Expansion> expand(const std::string& word, unsigned maxEdits) const;
+
+    // Renumbers the live documents and drops tombstoned postings.
+    void compact();
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+    File: TreeStats.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Prometheus text exposition of RedBlackTree statistics
+*/
+
+#include "TreeStats.h"
+
+namespace {
+    void writeGauge(std::ostream& out, const std::string& name, const char* help, std::uint64_t value) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " gauge\n" << name << " " << value << "\n";
+    }
+
+    void writeCounter(std::ostream& out, const std::string& name, const char* help, std::uint64_t value) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " counter\n" << name << " " << value << "\n";
+    }
+
+    // Prometheus histograms are cumulative and in seconds.
+    void writeHistogram(std::ostream& out, const std::string& name, const char* help, const HistogramSnapshot& h) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " histogram\n";
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b + 1 < h.bucketCount; ++b) {
+            cumulative += h.buckets[b];
+            out << name << "_bucket{le=\"" << static_cast<double>(h.bucketLimit(b)) * 1e-9 << "\"} " << cumulative << "\n";
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << h.count << "\n";
+        out << name << "_sum " << static_cast<double>(h.totalNanoseconds) * 1e-9 << "\n";
+        out << name << "_count " << h.count << "\n";
+    }
+}
+
+/*
+* writeTreeStats: Shape and memory gauges always; counters and histograms only when the build
+*                 is instrumented, so dashboards never show misleading zeros.
+*/
+void writeTreeStats(std::ostream& out, const TreeStats& stats, const std::string& prefix) {
+    writeGauge(out, prefix + "_nodes", "Courses stored in the tree.", stats.nodeCount);
+    writeGauge(out, prefix + "_height", "Nodes on the longest root-to-leaf path.", stats.height);
+    writeGauge(out, prefix + "_black_height", "Black nodes on every root-to-leaf path.", stats.blackHeight);
+    writeGauge(out, prefix + "_bytes_used", "Bytes held by live nodes and their strings.", stats.bytesUsed);
+    writeGauge(out, prefix + "_bytes_reserved", "Bytes reserved by the node arena plus string memory.", stats.bytesReserved);
+    if (!stats.instrumented)
+        return;
+
+    const TreeCounters& c = stats.counters;
+    writeCounter(out, prefix + "_inserts_total", "Nodes inserted one at a time.", c.inserts);
+    writeCounter(out, prefix + "_erases_total", "Nodes erased.", c.erases);
+    writeCounter(out, prefix + "_searches_total", "Single-key lookups, including batched ones.", c.searches);
+    writeCounter(out, prefix + "_search_steps_total", "Nodes compared during lookups.", c.searchSteps);
+    writeCounter(out, prefix + "_left_rotations_total", "Left rotations.", c.leftRotations);
+    writeCounter(out, prefix + "_right_rotations_total", "Right rotations.", c.rightRotations);
+    writeCounter(out, prefix + "_recolorings_total", "Color changes made by the insert and erase fixups.", c.recolorings);
+    writeCounter(out, prefix + "_insert_fixup_iterations_total", "Insert fixup loop iterations.", c.insertFixupIterations);
+    writeCounter(out, prefix + "_erase_fixup_iterations_total", "Erase fixup loop iterations.", c.eraseFixupIterations);
+    writeHistogram(out, prefix + "_insert_latency_seconds", "Latency of insert().", stats.insertLatency);
+    writeHistogram(out, prefix + "_search_latency_seconds", "Latency of search().", stats.searchLatency);
+}
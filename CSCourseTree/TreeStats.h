@@ -0,0 +1,194 @@
+/*
+    File: TreeStats.h
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Structure: TreeStats, TreeCounters, LatencyHistogram
+    Description: Shape statistics and optional operation counters / latency histograms for RedBlackTree
+*/
+#ifndef TREE_STATS_H
+#define TREE_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*
+* Instrumentation is compiled in only when COURSETREE_INSTRUMENTATION is defined for the whole
+* build (CMake: -DCOURSETREE_INSTRUMENTATION=ON). Without it the hooks in Course.cpp expand to
+* nothing, the tree core gets NoTreeEvents instead of TreeMetricsEvents, and RedBlackTree has no
+* extra members; stats() still reports the tree's shape and size.
+*/
+
+// Counter values at the time stats() was called.
+struct TreeCounters {
+    std::uint64_t inserts = 0;
+    std::uint64_t erases = 0;
+    std::uint64_t searches = 0;                 // single-key lookups, including batched ones
+    std::uint64_t searchSteps = 0;              // nodes compared across all lookups
+    std::uint64_t leftRotations = 0;
+    std::uint64_t rightRotations = 0;
+    std::uint64_t recolorings = 0;              // color assignments made by the fixups
+    std::uint64_t insertFixupIterations = 0;
+    std::uint64_t eraseFixupIterations = 0;
+};
+
+// Copy of a LatencyHistogram's buckets.
+struct HistogramSnapshot {
+    static constexpr std::size_t bucketCount = 40;
+
+    std::array<std::uint64_t, bucketCount> buckets{};  // bucket b: latencies below 2^b ns (and at least 2^(b-1))
+    std::uint64_t count = 0;
+    std::uint64_t totalNanoseconds = 0;
+
+    // Exclusive upper bound of bucket b in nanoseconds; the last bucket is open-ended.
+    static std::uint64_t bucketLimit(std::size_t b) { return std::uint64_t(1) << b; }
+
+    // Upper bound of the bucket holding the p-th percentile (0-100), or 0 with no samples.
+    std::uint64_t percentile(double p) const {
+        if (count == 0)
+            return 0;
+        double target = p / 100.0 * static_cast<double>(count);
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < bucketCount; ++b) {
+            seen += buckets[b];
+            if (static_cast<double>(seen) >= target && buckets[b])
+                return bucketLimit(b);
+        }
+        return bucketLimit(bucketCount - 1);
+    }
+};
+
+/*
+* Class: LatencyHistogram
+* Description: Power-of-two latency buckets updated with relaxed atomics, so concurrent
+*              const lookups can record into the same tree.
+*/
+class LatencyHistogram {
+private:
+    std::array<std::atomic<std::uint64_t>, HistogramSnapshot::bucketCount> buckets{};
+    std::atomic<std::uint64_t> count{ 0 };
+    std::atomic<std::uint64_t> totalNanoseconds{ 0 };
+
+public:
+    void record(std::uint64_t nanoseconds) {
+        std::size_t b = 0;
+        while (b + 1 < HistogramSnapshot::bucketCount && nanoseconds >= HistogramSnapshot::bucketLimit(b))
+            ++b;
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot s;
+        for (std::size_t b = 0; b < s.bucketCount; ++b)
+            s.buckets[b] = buckets[b].load(std::memory_order_relaxed);
+        s.count = count.load(std::memory_order_relaxed);
+        s.totalNanoseconds = totalNanoseconds.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() {
+        for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        totalNanoseconds.store(0, std::memory_order_relaxed);
+    }
+};
+
+/*
+* Structure: TreeMetrics
+* Description: The live counters and histograms a tree owns when instrumentation is on.
+*/
+struct TreeMetrics {
+    std::atomic<std::uint64_t> inserts{ 0 };
+    std::atomic<std::uint64_t> erases{ 0 };
+    std::atomic<std::uint64_t> searches{ 0 };
+    std::atomic<std::uint64_t> searchSteps{ 0 };
+    std::atomic<std::uint64_t> leftRotations{ 0 };
+    std::atomic<std::uint64_t> rightRotations{ 0 };
+    std::atomic<std::uint64_t> recolorings{ 0 };
+    std::atomic<std::uint64_t> insertFixupIterations{ 0 };
+    std::atomic<std::uint64_t> eraseFixupIterations{ 0 };
+    LatencyHistogram insertLatency;
+    LatencyHistogram searchLatency;
+
+    TreeCounters counters() const {
+        TreeCounters c;
+        c.inserts = inserts.load(std::memory_order_relaxed);
+        c.erases = erases.load(std::memory_order_relaxed);
+        c.searches = searches.load(std::memory_order_relaxed);
+        c.searchSteps = searchSteps.load(std::memory_order_relaxed);
+        c.leftRotations = leftRotations.load(std::memory_order_relaxed);
+        c.rightRotations = rightRotations.load(std::memory_order_relaxed);
+        c.recolorings = recolorings.load(std::memory_order_relaxed);
+        c.insertFixupIterations = insertFixupIterations.load(std::memory_order_relaxed);
+        c.eraseFixupIterations = eraseFixupIterations.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    void reset() {
+        for (auto* counter : { &inserts, &erases, &searches, &searchSteps, &leftRotations, &rightRotations,
+                               &recolorings, &insertFixupIterations, &eraseFixupIterations })
+            counter->store(0, std::memory_order_relaxed);
+        insertLatency.reset();
+        searchLatency.reset();
+    }
+};
+
+/*
+* Structure: TreeMetricsEvents
+* Description: BasicRedBlackTree event hooks that count into a TreeMetrics.
+*/
+struct TreeMetricsEvents {
+    TreeMetrics* metrics = nullptr;
+
+    void searchStep() const { metrics->searchSteps.fetch_add(1, std::memory_order_relaxed); }
+    void leftRotation() const { metrics->leftRotations.fetch_add(1, std::memory_order_relaxed); }
+    void rightRotation() const { metrics->rightRotations.fetch_add(1, std::memory_order_relaxed); }
+    void recolored(unsigned count) const { metrics->recolorings.fetch_add(count, std::memory_order_relaxed); }
+    void insertFixupStep() const { metrics->insertFixupIterations.fetch_add(1, std::memory_order_relaxed); }
+    void eraseFixupStep() const { metrics->eraseFixupIterations.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Records the lifetime of the enclosing scope into a histogram.
+class ScopedLatency {
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedLatency(LatencyHistogram& target) : histogram(target), start(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        histogram.record(static_cast<std::uint64_t>(elapsed.count()));
+    }
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+/*
+* Structure: TreeStats
+* Description: Everything RedBlackTree::stats() reports. Shape and memory figures are always
+*              filled in; counters and histograms are zero unless instrumented is true.
+*/
+struct TreeStats {
+    std::size_t nodeCount = 0;
+    std::size_t height = 0;             // nodes on the longest root-to-leaf path
+    std::size_t blackHeight = 0;        // black nodes on every root-to-leaf path, root included
+    std::size_t bytesUsed = 0;          // live nodes plus the heap memory their strings own
+    std::size_t bytesReserved = 0;      // arena blocks (including unused slots) plus string heap memory
+    bool instrumented = false;
+    TreeCounters counters;
+    HistogramSnapshot insertLatency;
+    HistogramSnapshot searchLatency;
+};
+
+// Writes stats in the Prometheus text exposition format, every metric name starting with prefix.
+void writeTreeStats(std::ostream& out, const TreeStats& stats, const std::string& prefix = "coursetree");
+
+#endif
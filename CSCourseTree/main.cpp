@@ -7,39 +7,92 @@
                  file, performing an in-order traversal to print courses, and searching
                  for a specific course.
 */
-#include "course.h"     // Include the header file that contains Course-related functions
+#include "Course.h"     // Include the header file that contains Course-related functions
+#include "CatalogServer.h" // Headless request server (--serve)
+#include "EligibilityEngine.h" // Which courses a student can take next
+#include "TitleIndex.h" // Keyword search over course titles
+#include <algorithm>
 #include <iostream>  
+#include <optional>
 #include <sstream>
 
 
 
+/*
+* serve: Headless mode. Loads the catalog once, then answers CatalogServer requests on
+*        stdin/stdout, or on a Unix domain socket when socketPath is set.
+*/
+static int serve(const std::string& fileName, const std::string& socketPath) {
+    RedBlackTree tree;
+    tree.loadDataStructure(fileName);
+    PrerequisiteGraph graph;
+    graph.build(tree);
+    CatalogServer server(tree, graph);
+    if (!socketPath.empty())
+        return server.serveSocket(socketPath) ? 0 : 1;
+    server.serveStream(0, 1);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
-    // Ensure the program name and csvFile name are given
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <file_name>" << std::endl;
+    // Interactive:  CSCourseTree <file_name>
+    // Headless:     CSCourseTree --serve [--socket <path>] <file_name>
+    bool serveMode = false;
+    std::string socketPath;
+    std::string fileName;
+    bool usageError = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--serve")
+            serveMode = true;
+        else if (arg == "--socket" && i + 1 < argc)
+            socketPath = argv[++i];
+        else if (fileName.empty() && arg.rfind("--", 0) != 0)
+            fileName = arg;
+        else
+            usageError = true;
+    }
+    // Ensure the csvFile name is given
+    if (usageError || fileName.empty() || (!socketPath.empty() && !serveMode)) {
+        std::cerr << "Usage: " << argv[0] << " <file_name>" << std::endl
+                  << "       " << argv[0] << " --serve [--socket <path>] <file_name>" << std::endl;
         return 1;
     }
-
-    std::string fileName(argv[1]);// Retrieve the fileName from command-line arguments
+    if (serveMode)
+        return serve(fileName, socketPath);
 
     RedBlackTree tree; // Create an instance of the RedBlackTree
+    TitleIndex titles; // Kept in sync with the tree as courses are loaded
+    tree.addObserver(&titles);
+    PrerequisiteGraph graph;                 // Built with the engine on the first eligibility query
+    std::optional<EligibilityEngine> engine; // Empty until then, and again after every load
     std::string courseNumber; // Declare courseNumber for user input
+    std::string keywords;     // Declare keywords for title searches
+    std::string completedLine; // Declare completedLine for eligibility queries
+    const std::size_t pageSize = 50; // Courses per page when browsing
+    std::size_t pageNumber = 0;      // Declare pageNumber for browsing
 
     int choice = 0;
-    while (choice != 4) {
+    while (choice != 7) {
+        bool lineRead = false; // Set when an option consumed the rest of the input line
         // Display menu options to the user
         std::cout << "Menu:" << std::endl;
         std::cout << "1. Load Data Structure (RBT)" << std::endl;
         std::cout << "2. Print Course List (RBT)" << std::endl;
         std::cout << "3. Print Course (RBT)" << std::endl;
-        std::cout << "4. Exit" << std::endl;
+        std::cout << "4. Search Course Titles" << std::endl;
+        std::cout << "5. Browse Course List" << std::endl;
+        std::cout << "6. Courses Eligible Next" << std::endl;
+        std::cout << "7. Exit" << std::endl;
         std::cout << "Enter your choice: ";
         std::cin >> choice; // Take user input for menu choice
 
         try {
             switch (choice) {
             case 1:
-                // Load courses from the CSV file.
+                // Load courses from the CSV file. The graph points at the old courses, so the
+                // engine is dropped first and rebuilt by the next eligibility query.
+                engine.reset();
                 tree.loadDataStructure(fileName);
                 std::cout << "Data loaded successfully." << std::endl;
 
@@ -53,8 +106,8 @@ int main(int argc, char* argv[]) {
                 std::cout << "Enter course number: ";
                 std::cin >> courseNumber;
                 {
-                    auto result = tree.search(courseNumber);
-                    if (result.has_value() && !result->courseNumber.empty()) {
+                    const Course* result = tree.find(courseNumber);
+                    if (result && !result->courseNumber.empty()) {
                         std::cout << "Found course: " << result->courseNumber << ": "
                             << result->courseTitle << " | Prerequisites: ";
                         result->printPrerequisites();
@@ -65,6 +118,59 @@ int main(int argc, char* argv[]) {
                 }
                 break;
             case 4:
+                // Keyword search over course titles; falls back to substring/typo matching.
+                std::cout << "Enter keywords: ";
+                std::getline(std::cin >> std::ws, keywords);
+                lineRead = true;
+                {
+                    auto matches = titles.search(keywords);
+                    if (matches.empty())
+                        matches = titles.fuzzySearch(keywords);
+                    if (matches.empty())
+                        std::cout << "No matching courses." << std::endl;
+                    for (const auto& match : matches)
+                        std::cout << match.course->courseNumber << ", " << match.course->courseTitle << std::endl;
+                }
+                break;
+            case 5:
+                // Show one page of the catalog in course-number order.
+                {
+                    std::size_t pageCount = (tree.size() + pageSize - 1) / pageSize;
+                    if (pageCount == 0) {
+                        std::cout << "No courses loaded." << std::endl;
+                        break;
+                    }
+                    std::cout << "Enter page number (1-" << pageCount << "): ";
+                    if (!(std::cin >> pageNumber) || pageNumber < 1 || pageNumber > pageCount)
+                        throw std::invalid_argument("Invalid page number.");
+                    auto [first, last] = tree.page((pageNumber - 1) * pageSize, pageSize);
+                    for (auto it = first; it != last; ++it)
+                        std::cout << it->courseNumber << ", " << it->courseTitle << std::endl;
+                }
+                break;
+            case 6:
+                // List the courses whose prerequisites the student has all completed.
+                std::cout << "Enter completed course numbers (separated by spaces or commas): ";
+                std::getline(std::cin >> std::ws, completedLine);
+                lineRead = true;
+                {
+                    std::replace(completedLine.begin(), completedLine.end(), ',', ' ');
+                    std::istringstream words(completedLine);
+                    std::vector<std::string> completed;
+                    for (std::string number; words >> number;)
+                        completed.push_back(number);
+                    if (!engine) {
+                        graph.build(tree);
+                        engine.emplace(graph);
+                    }
+                    std::vector<std::uint32_t> eligible = engine->eligible(engine->completedSet(completed));
+                    if (eligible.empty())
+                        std::cout << "No eligible courses." << std::endl;
+                    for (std::uint32_t id : eligible)
+                        std::cout << graph.course(id).courseNumber << ", " << graph.course(id).courseTitle << std::endl;
+                }
+                break;
+            case 7:
                 std::cout << "Exiting the program..." << std::endl;
                 break;
             default:
@@ -79,7 +185,8 @@ int main(int argc, char* argv[]) {
         }
 
         std::cin.clear(); // Clear the input stream state
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore any remaining characters in the input buffer
+        if (!lineRead)
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore any remaining characters in the input buffer
     }
 
     return 0;
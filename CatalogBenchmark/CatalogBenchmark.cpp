@@ -0,0 +1,1115 @@
+/*
+    File: CatalogBenchmark.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Non-interactive benchmark suite for the course catalog. Generates catalogs of
+                 several sizes and key distributions, runs each case with warmup and repeated
+                 trials, and reports percentiles as a text table, JSON or CSV.
+                 Run with --help for the options.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../CSCourseTree/CatalogSnapshot.h"
+#include "../CSCourseTree/ClosureCache.h"
+#include "../CSCourseTree/Course.h"
+#include "../CSCourseTree/CsvLoader.h"
+#include "../CSCourseTree/DegreePlanner.h"
+#include "../CSCourseTree/EligibilityEngine.h"
+#include "../CSCourseTree/FrozenCatalog.h"
+#include "../CSCourseTree/ShardedCatalog.h"
+#include "../CSCourseTree/SnapshotTree.h"
+#include "../CSCourseTree/TitleIndex.h"
+
+/*
+* Heap accounting: every global new/delete in this program goes through these replacements,
+* which keep a running total of live bytes so the memory case can measure the tree exactly, and
+* count allocations for the *-allocs cases.
+*/
+namespace {
+    std::atomic<long long> liveHeapBytes{ 0 };
+    std::atomic<long long> heapAllocations{ 0 };
+    constexpr std::size_t allocationHeader = 16;    // keeps the default new alignment
+}
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + allocationHeader);
+    if (!block)
+        throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    liveHeapBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*>(block) + allocationHeader;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer)
+        return;
+    // Integer arithmetic: GCC's bounds checker flags pointer arithmetic before an object's start.
+    void* block = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(pointer) - allocationHeader);
+    liveHeapBytes.fetch_sub(static_cast<long long>(*static_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Written by timed loops so the optimizer cannot drop the work being measured.
+volatile std::size_t benchmarkSink = 0;
+
+struct Options {
+    std::vector<std::size_t> sizes{ 10000, 100000, 1000000 };
+    std::vector<std::string> distributions{ "sequential", "shuffled", "departments" };
+    std::vector<std::string> cases;         // empty = all
+    int trials = 5;
+    int warmup = 1;
+    std::size_t lookups = 200000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned seed = 42;
+    std::string format = "text";
+    std::string output;
+    std::filesystem::path workDir = std::filesystem::temp_directory_path();
+};
+
+// One generated catalog plus the key sets the lookup cases draw from.
+struct Dataset {
+    std::string distribution;
+    std::vector<Course> courses;            // in file order
+    std::vector<std::string> hitKeys;
+    std::vector<std::string> missKeys;
+    std::string csvPath;
+};
+
+struct Result {
+    std::string caseName;
+    std::string distribution;
+    std::size_t size = 0;
+    std::string unit;                       // "ns/op", "bytes/course", "allocs/course" or "allocs/op"
+    std::vector<double> samples;            // one per trial, already divided by the operation count
+};
+
+const char* const allCases[] = {
+    "parse", "parse-parallel", "load", "insert", "bulk-load", "search-hit", "search-miss", "search-batch",
+    "traversal", "memory", "schedule", "snapshot-open", "snapshot-read", "snapshot-read-writer",
+    "title-index", "title-search", "title-fuzzy", "freeze", "frozen-search-hit", "frozen-search-miss",
+    "frozen-search-batch", "range-scan", "frozen-range-scan", "rank", "page", "sharded-load",
+    "sharded-search", "sharded-traversal", "find-hit", "load-allocs", "search-allocs", "find-allocs",
+    "eligible", "eligible-batch", "closure-tree", "closure-graph", "closure-cold", "closure-warm",
+    "closure-invalidate"
+};
+
+/*
+* usage: Prints the command-line options.
+*/
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+        << "  --sizes N,N,...         catalog sizes (default 10000,100000,1000000)\n"
+        << "  --distributions a,b     sequential, shuffled, departments (default all)\n"
+        << "  --cases a,b             benchmark cases (default all):\n"
+        << "                          ";
+    for (const char* name : allCases)
+        std::cerr << name << " ";
+    std::cerr << "\n"
+        << "  --trials N              timed trials per case (default 5)\n"
+        << "  --warmup N              untimed warmup runs per case (default 1)\n"
+        << "  --lookups N             keys per lookup trial (default 200000)\n"
+        << "  --threads N             worker threads for parse-parallel, sharded-load,\n"
+        << "                          eligible-batch and snapshot-read\n"
+        << "                          (default: hardware threads)\n"
+        << "  --seed N                random seed (default 42)\n"
+        << "  --format text|json|csv  output format (default text)\n"
+        << "  --output FILE           write results to FILE instead of stdout\n"
+        << "  --work-dir DIR          where generated CSV and snapshot files go (default: temp dir)\n";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+/*
+* parseOptions: Reads --name value pairs. Returns false (after printing usage) on any error.
+*/
+bool parseOptions(int argc, char* argv[], Options& options) {
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string name = argv[i];
+            if (name == "--help" || name == "-h") {
+                usage(argv[0]);
+                return false;
+            }
+            if (i + 1 >= argc)
+                throw std::invalid_argument("missing value for " + name);
+            std::string value = argv[++i];
+            if (name == "--sizes") {
+                options.sizes.clear();
+                for (const auto& item : splitList(value))
+                    options.sizes.push_back(static_cast<std::size_t>(std::stoull(item)));
+            }
+            else if (name == "--distributions")
+                options.distributions = splitList(value);
+            else if (name == "--cases")
+                options.cases = splitList(value);
+            else if (name == "--trials")
+                options.trials = std::max(1, std::stoi(value));
+            else if (name == "--warmup")
+                options.warmup = std::max(0, std::stoi(value));
+            else if (name == "--lookups")
+                options.lookups = std::max<std::size_t>(1, std::stoull(value));
+            else if (name == "--threads")
+                options.threads = std::max(1, std::stoi(value));
+            else if (name == "--seed")
+                options.seed = static_cast<unsigned>(std::stoul(value));
+            else if (name == "--format")
+                options.format = value;
+            else if (name == "--output")
+                options.output = value;
+            else if (name == "--work-dir")
+                options.workDir = value;
+            else
+                throw std::invalid_argument("unknown option " + name);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        usage(argv[0]);
+        return false;
+    }
+    for (const auto& distribution : options.distributions) {
+        if (distribution != "sequential" && distribution != "shuffled" && distribution != "departments") {
+            std::cerr << "Error: unknown distribution " << distribution << "\n";
+            return false;
+        }
+    }
+    for (const auto& name : options.cases) {
+        if (std::find(std::begin(allCases), std::end(allCases), name) == std::end(allCases)) {
+            std::cerr << "Error: unknown case " << name << "\n";
+            return false;
+        }
+    }
+    if (options.format != "text" && options.format != "json" && options.format != "csv") {
+        std::cerr << "Error: unknown format " << options.format << "\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+* makeCourseNumbers: Generates count unique course numbers in file order.
+*   sequential  - TEST0000000, TEST0000001, ... ascending (the TestDataGenerator shape)
+*   shuffled    - the same keys in random order
+*   departments - 2-8 letter department codes with skewed sizes and 3-5 digit numbers, in
+*                 random order; long codes exercise keys past the 8-byte packed prefix
+*/
+std::vector<std::string> makeCourseNumbers(const std::string& distribution, std::size_t count, std::mt19937_64& rng) {
+    std::vector<std::string> numbers;
+    numbers.reserve(count);
+    if (distribution != "departments") {
+        char buffer[32];
+        for (std::size_t i = 0; i < count; ++i) {
+            std::snprintf(buffer, sizeof(buffer), "TEST%07zu", i);
+            numbers.emplace_back(buffer);
+        }
+        if (distribution == "shuffled")
+            std::shuffle(numbers.begin(), numbers.end(), rng);
+        return numbers;
+    }
+
+    static const char* const departments[] = {
+        "CS", "CSCI", "MATH", "PHYS", "CHEM", "BIO", "ENGL", "HIST", "ECON", "PSYC",
+        "PHIL", "ART", "MUS", "SOC", "STAT", "GEOG", "LING", "ASTR", "NURS", "EDUC",
+        "BIOCHEM", "ANTHRO", "ECE", "MECHENG", "CIVENG", "JOURNAL", "THEATRE", "COMPLIT"
+    };
+    const std::size_t departmentCount = sizeof(departments) / sizeof(departments[0]);
+    // Department d gets weight 1/(d+1), so a few departments hold most of the catalog.
+    std::vector<double> weights(departmentCount);
+    for (std::size_t d = 0; d < departmentCount; ++d)
+        weights[d] = 1.0 / static_cast<double>(d + 1);
+    std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+
+    std::vector<std::size_t> nextNumber(departmentCount, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t d = pick(rng);
+        std::size_t n = nextNumber[d]++;
+        // 3 digits while they last, then 4, then 5+, so codes keep a realistic look.
+        std::string digits = std::to_string(n < 900 ? 100 + n : n < 9900 ? 1000 + n - 900 : 10000 + n - 9900);
+        numbers.push_back(departments[d] + digits);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), rng);
+    return numbers;
+}
+
+/*
+* makeDataset: Builds the courses (with TestDataGenerator's prerequisite pattern), the hit and
+*              miss key sets, and writes the catalog to a CSV file for the file-based cases.
+*/
+Dataset makeDataset(const std::string& distribution, std::size_t count, const Options& options) {
+    std::mt19937_64 rng(options.seed);
+    Dataset data;
+    data.distribution = distribution;
+    std::vector<std::string> numbers = makeCourseNumbers(distribution, count, rng);
+
+    // Prerequisites always point at courses earlier in sorted order, so the catalog is acyclic.
+    std::vector<std::string> sorted = numbers;
+    std::sort(sorted.begin(), sorted.end());
+    data.courses.reserve(count);
+    for (const auto& number : numbers) {
+        Course course(number, "Course Title for " + number);
+        std::size_t rank = static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), number) - sorted.begin());
+        std::size_t mod = rank % 4;
+        if ((mod == 1 || mod == 2) && rank >= 1)
+            course.addPrerequisite(sorted[rank - 1]);
+        else if (mod == 3 && rank >= 3) {
+            course.addPrerequisite(sorted[rank - 1]);
+            course.addPrerequisite(sorted[rank - 3]);
+        }
+        data.courses.push_back(std::move(course));
+    }
+
+    data.hitKeys.resize(options.lookups);
+    data.missKeys.resize(options.lookups);
+    for (std::size_t i = 0; i < options.lookups; ++i) {
+        const std::string& key = numbers[rng() % count];
+        data.hitKeys[i] = key;
+        // Near misses share the whole prefix of a real key, the most expensive kind to reject.
+        data.missKeys[i] = key + "X";
+    }
+
+    std::filesystem::create_directories(options.workDir);
+    data.csvPath = (options.workDir / ("catalog_bench_" + distribution + "_" + std::to_string(count) + ".csv")).string();
+    std::ofstream out(data.csvPath, std::ios::binary);
+    std::string line;
+    for (const auto& course : data.courses) {
+        line = course.courseNumber + "," + course.courseTitle;
+        for (const auto& prereq : course.prerequisites)
+            line += "," + prereq;
+        line += "\n";
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+    if (!out)
+        throw std::runtime_error("could not write " + data.csvPath);
+    return data;
+}
+
+/*
+* TitleWorkload: The dataset's courses retitled with words drawn from a Zipf-distributed
+*                vocabulary (a few very common words, a long tail of rare ones, as in a real
+*                catalog), plus two-word queries taken from those titles and a misspelled copy
+*                of each for the fuzzy case.
+*/
+struct TitleWorkload {
+    std::vector<Course> courses;
+    std::vector<std::string> queries;
+    std::vector<std::string> misspelled;
+};
+
+TitleWorkload makeTitleWorkload(const Dataset& data, const Options& options) {
+    std::mt19937_64 rng(options.seed + 1);
+    const std::size_t vocabularySize = 5000;
+    std::vector<std::string> vocabulary;
+    std::vector<double> cumulative;
+    double total = 0;
+    for (std::size_t k = 0; k < vocabularySize; ++k) {
+        std::string word(3 + rng() % 8, ' ');
+        for (char& c : word)
+            c = static_cast<char>('a' + rng() % 26);
+        vocabulary.push_back(word);
+        total += 1.0 / static_cast<double>(k + 1);
+        cumulative.push_back(total);
+    }
+
+    std::uniform_real_distribution<double> unit(0.0, total);
+    TitleWorkload workload;
+    workload.courses = data.courses;
+    std::vector<std::vector<std::size_t>> titleWords(workload.courses.size());
+    for (std::size_t i = 0; i < workload.courses.size(); ++i) {
+        std::size_t words = 2 + rng() % 4;
+        std::string title;
+        while (titleWords[i].size() < words) {
+            std::size_t pick = static_cast<std::size_t>(std::lower_bound(cumulative.begin(), cumulative.end(), unit(rng)) - cumulative.begin());
+            pick = std::min(pick, vocabularySize - 1);
+            // Real titles rarely repeat a word.
+            if (std::find(titleWords[i].begin(), titleWords[i].end(), pick) != titleWords[i].end())
+                continue;
+            if (!title.empty())
+                title += ' ';
+            title += vocabulary[pick];
+            titleWords[i].push_back(pick);
+        }
+        workload.courses[i].courseTitle = title;
+    }
+
+    const std::size_t queryCount = 1000;
+    for (std::size_t q = 0; q < queryCount; ++q) {
+        const auto& words = titleWords[rng() % titleWords.size()];
+        std::size_t pick = rng() % words.size();
+        std::string first = vocabulary[words[pick]];
+        std::string second = vocabulary[words[(pick + 1 + rng() % (words.size() - 1)) % words.size()]];
+        workload.queries.push_back(first + " " + second);
+        // One adjacent transposition in the longer word.
+        std::string& longer = first.size() >= second.size() ? first : second;
+        if (longer.size() >= 4) {
+            std::size_t at = 1 + rng() % (longer.size() - 2);
+            std::swap(longer[at], longer[at + 1]);
+        }
+        workload.misspelled.push_back(first + " " + second);
+    }
+    return workload;
+}
+
+/*
+* makeStudents: Completed sets for the eligibility cases: 32 random courses per student, each
+*               with its direct prerequisites, so some of their dependents become eligible.
+*               Fewer students on large catalogs keep the one-at-a-time case's trials short.
+*/
+std::vector<std::vector<std::uint32_t>> makeStudents(const PrerequisiteGraph& graph, const Options& options) {
+    std::size_t count = std::clamp<std::size_t>((std::size_t(1) << 28) / std::max<std::size_t>(1, graph.size()), 256, 4096);
+    std::mt19937 rng(options.seed + 7);
+    std::vector<std::vector<std::uint32_t>> students(count);
+    for (auto& student : students) {
+        for (int i = 0; i < 32 && graph.size() > 0; ++i) {
+            std::uint32_t id = static_cast<std::uint32_t>(rng() % graph.size());
+            student.push_back(id);
+            for (std::uint32_t prereq : graph.prerequisitesOf(id))
+                student.push_back(prereq);
+        }
+    }
+    return students;
+}
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/*
+* measure: Runs warmup untimed trials, then the timed ones. Each trial returns its own
+*          measurement (so per-trial setup stays outside the timed region), which is divided
+*          by operations to give one sample.
+*/
+Result measure(const std::string& caseName, const Dataset& data, const Options& options, const std::string& unit,
+               double operations, const std::function<double()>& trial) {
+    Result result;
+    result.caseName = caseName;
+    result.distribution = data.distribution;
+    result.size = data.courses.size();
+    result.unit = unit;
+    for (int i = 0; i < options.warmup; ++i)
+        trial();
+    for (int i = 0; i < options.trials; ++i)
+        result.samples.push_back(trial() / operations);
+    return result;
+}
+
+/*
+* snapshotReadTrial: readerCount threads each do lookupsPerReader snapshot searches, with
+*                    an optional writer upserting until they finish. Returns wall-clock ns.
+*/
+double snapshotReadTrial(SnapshotTree& snapshots, const Dataset& data, unsigned readerCount,
+                         std::size_t lookupsPerReader, bool withWriter) {
+    std::atomic<bool> stop{ false };
+    std::thread writer;
+    if (withWriter) {
+        writer = std::thread([&]() {
+            std::size_t i = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string& key = data.hitKeys[i++ % data.hitKeys.size()];
+                snapshots.upsert(Course(key, "Updated title for " + key));
+            }
+        });
+    }
+    auto start = Clock::now();
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            std::size_t found = 0;
+            std::size_t offset = r * 7919;
+            auto snapshot = snapshots.snapshot();
+            for (std::size_t i = 0; i < lookupsPerReader; ++i) {
+                if (snapshot.search(data.hitKeys[(offset + i) % data.hitKeys.size()]))
+                    ++found;
+            }
+            benchmarkSink = found;
+        });
+    }
+    for (auto& reader : readers)
+        reader.join();
+    double ns = elapsedNs(start);
+    stop = true;
+    if (writer.joinable())
+        writer.join();
+    return ns;
+}
+
+/*
+* ClosureWorkload: The dataset's course numbers rewired into overlapping chains: in sorted
+*                  order, each course requires the one before it and the one three before,
+*                  within runs of 64, so closures average about 32 courses and share most of
+*                  them with their neighbours. queries are at most 20000 of the hit keys.
+*/
+struct ClosureWorkload {
+    std::vector<Course> courses;
+    std::vector<std::string> queries;
+};
+
+ClosureWorkload makeClosureWorkload(const Dataset& data) {
+    constexpr std::size_t runLength = 64;
+    ClosureWorkload workload;
+    std::vector<std::string> sorted;
+    sorted.reserve(data.courses.size());
+    for (const auto& course : data.courses)
+        sorted.push_back(course.courseNumber);
+    std::sort(sorted.begin(), sorted.end());
+    workload.courses.reserve(sorted.size());
+    for (std::size_t rank = 0; rank < sorted.size(); ++rank) {
+        Course course(sorted[rank], "Course Title for " + sorted[rank]);
+        if (rank % runLength >= 1)
+            course.addPrerequisite(sorted[rank - 1]);
+        if (rank % runLength >= 3)
+            course.addPrerequisite(sorted[rank - 3]);
+        workload.courses.push_back(std::move(course));
+    }
+    std::size_t queryCount = std::min<std::size_t>(data.hitKeys.size(), 20000);
+    workload.queries.assign(data.hitKeys.begin(), data.hitKeys.begin() + queryCount);
+    return workload;
+}
+
+/*
+* runCase: Runs one named case against a dataset.
+*/
+Result runCase(const std::string& name, const Dataset& data, const Options& options) {
+    const double n = static_cast<double>(data.courses.size());
+    const double lookups = static_cast<double>(data.hitKeys.size());
+
+    if (name == "parse") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            std::vector<Course> courses;
+            std::vector<CsvParseError> errors;
+            auto start = Clock::now();
+            MappedFile file;
+            file.open(data.csvPath);
+            parseCourseCsv(file.view(), courses, errors);
+            double ns = elapsedNs(start);
+            benchmarkSink = courses.size();
+            return ns;
+        });
+    }
+    if (name == "parse-parallel") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            std::vector<Course> courses;
+            std::vector<CsvParseError> errors;
+            auto start = Clock::now();
+            MappedFile file;
+            file.open(data.csvPath);
+            parseCourseCsvParallel(file.view(), courses, errors, options.threads);
+            double ns = elapsedNs(start);
+            benchmarkSink = courses.size();
+            return ns;
+        });
+    }
+    if (name == "load") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            RedBlackTree tree;
+            auto start = Clock::now();
+            tree.loadDataStructure(data.csvPath);
+            double ns = elapsedNs(start);
+            benchmarkSink = tree.size();
+            return ns;
+        });
+    }
+    if (name == "insert") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            RedBlackTree tree;
+            auto start = Clock::now();
+            for (const auto& course : data.courses)
+                tree.insert(course);
+            double ns = elapsedNs(start);
+            benchmarkSink = tree.size();
+            return ns;
+        });
+    }
+    if (name == "bulk-load") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            RedBlackTree tree;
+            std::vector<Course> courses = data.courses;
+            auto start = Clock::now();
+            tree.bulkLoad(std::move(courses));
+            double ns = elapsedNs(start);
+            benchmarkSink = tree.size();
+            return ns;
+        });
+    }
+    if (name == "sharded-load") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            ShardedCatalog catalog(options.threads);
+            auto start = Clock::now();
+            catalog.load(data.csvPath);
+            double ns = elapsedNs(start);
+            benchmarkSink = catalog.size();
+            return ns;
+        });
+    }
+    if (name == "sharded-search" || name == "sharded-traversal") {
+        ShardedCatalog catalog(options.threads);
+        catalog.load(data.csvPath);
+        if (name == "sharded-traversal") {
+            return measure(name, data, options, "ns/op", n, [&]() {
+                std::size_t bytes = 0;
+                auto start = Clock::now();
+                catalog.forEachInOrder([&](const Course& course) { bytes += course.courseNumber.size(); });
+                double ns = elapsedNs(start);
+                benchmarkSink = bytes;
+                return ns;
+            });
+        }
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (const auto& key : data.hitKeys) {
+                if (catalog.search(key))
+                    ++found;
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+    if (name == "memory") {
+        return measure(name, data, options, "bytes/course", n, [&]() {
+            long long before = liveHeapBytes.load();
+            RedBlackTree tree;
+            tree.loadDataStructure(data.csvPath);
+            return static_cast<double>(liveHeapBytes.load() - before);
+        });
+    }
+    if (name == "load-allocs") {
+        return measure(name, data, options, "allocs/course", n, [&]() {
+            long long before = heapAllocations.load();
+            RedBlackTree tree;
+            tree.loadDataStructure(data.csvPath);
+            return static_cast<double>(heapAllocations.load() - before);
+        });
+    }
+    if (name == "snapshot-open") {
+        std::string snapshotPath = data.csvPath + ".snap";
+        {
+            RedBlackTree tree;
+            tree.bulkLoad(std::vector<Course>(data.courses));
+            writeCatalogSnapshot(tree, snapshotPath);
+        }
+        return measure(name, data, options, "ns/op", 1.0, [&]() {
+            auto start = Clock::now();
+            CatalogSnapshot snapshot;
+            snapshot.open(snapshotPath);
+            benchmarkSink = snapshot.find(data.hitKeys[0]);
+            return elapsedNs(start);
+        });
+    }
+
+    if (name == "title-index" || name == "title-search" || name == "title-fuzzy") {
+        TitleWorkload workload = makeTitleWorkload(data, options);
+        RedBlackTree titled;
+        titled.bulkLoad(std::move(workload.courses));
+        if (name == "title-index") {
+            return measure(name, data, options, "ns/op", n, [&]() {
+                TitleIndex index;
+                auto start = Clock::now();
+                titled.addObserver(&index);
+                double ns = elapsedNs(start);
+                titled.removeObserver(&index);
+                benchmarkSink = index.vocabularySize();
+                return ns;
+            });
+        }
+        TitleIndex index;
+        titled.addObserver(&index);
+        bool fuzzy = name == "title-fuzzy";
+        const std::vector<std::string>& queries = fuzzy ? workload.misspelled : workload.queries;
+        return measure(name, data, options, "ns/op", static_cast<double>(queries.size()), [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (const auto& query : queries)
+                found += (fuzzy ? index.fuzzySearch(query) : index.search(query)).size();
+            double ns = elapsedNs(start);
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+
+    // The remaining cases query a tree built once.
+    RedBlackTree tree;
+    tree.bulkLoad(std::vector<Course>(data.courses));
+
+    if (name == "search-hit" || name == "search-miss") {
+        const std::vector<std::string>& keys = name == "search-hit" ? data.hitKeys : data.missKeys;
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (const auto& key : keys) {
+                if (tree.search(key))
+                    ++found;
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+    if (name == "find-hit") {
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (const auto& key : data.hitKeys) {
+                if (tree.find(key))
+                    ++found;
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+    if (name == "search-allocs" || name == "find-allocs") {
+        // Hits only: a miss allocates nothing either way.
+        bool copying = name == "search-allocs";
+        return measure(name, data, options, "allocs/op", lookups, [&]() {
+            std::size_t found = 0;
+            long long before = heapAllocations.load();
+            for (const auto& key : data.hitKeys) {
+                if (copying ? tree.search(key).has_value() : tree.find(key) != nullptr)
+                    ++found;
+            }
+            benchmarkSink = found;
+            return static_cast<double>(heapAllocations.load() - before);
+        });
+    }
+    if (name == "search-batch") {
+        std::vector<const Course*> results;
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            auto start = Clock::now();
+            tree.searchBatch(data.hitKeys, results);
+            double ns = elapsedNs(start);
+            benchmarkSink = results.size();
+            return ns;
+        });
+    }
+    if (name == "rank") {
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t total = 0;
+            auto start = Clock::now();
+            for (const auto& key : data.hitKeys)
+                total += tree.rank(key);
+            double ns = elapsedNs(start);
+            benchmarkSink = total;
+            return ns;
+        });
+    }
+    if (name == "page") {
+        // Pages of 50 at offsets spread over the whole catalog, so deep pages count as much
+        // as the first ones. Reported per page.
+        constexpr std::size_t pageSize = 50;
+        std::vector<std::size_t> offsets(std::min<std::size_t>(data.hitKeys.size(), 20000));
+        std::mt19937_64 rng(options.seed);
+        for (auto& offset : offsets)
+            offset = rng() % data.courses.size();
+        return measure(name, data, options, "ns/op", static_cast<double>(offsets.size()), [&]() {
+            std::size_t bytes = 0;
+            auto start = Clock::now();
+            for (std::size_t offset : offsets) {
+                auto [first, last] = tree.page(offset, pageSize);
+                for (auto it = first; it != last; ++it)
+                    bytes += it->courseNumber.size();
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = bytes;
+            return ns;
+        });
+    }
+    if (name == "freeze") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            auto start = Clock::now();
+            FrozenCatalog frozen = tree.freeze();
+            double ns = elapsedNs(start);
+            benchmarkSink = frozen.size();
+            return ns;
+        });
+    }
+    if (name == "range-scan" || name == "frozen-range-scan") {
+        // Each probe positions on a key and reads the next rangeLength courses, like a page of
+        // results in course-number order.
+        constexpr std::size_t rangeLength = 16;
+        FrozenCatalog frozen = tree.freeze();
+        bool useFrozen = name == "frozen-range-scan";
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t bytes = 0;
+            auto start = Clock::now();
+            for (const auto& key : data.hitKeys) {
+                if (useFrozen) {
+                    auto it = frozen.lower_bound(key);
+                    for (std::size_t i = 0; i < rangeLength && it != frozen.end(); ++i, ++it)
+                        bytes += it->courseNumber.size();
+                }
+                else {
+                    auto it = tree.lower_bound(key);
+                    for (std::size_t i = 0; i < rangeLength && it != tree.end(); ++i, ++it)
+                        bytes += it->courseNumber.size();
+                }
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = bytes;
+            return ns;
+        });
+    }
+    if (name == "frozen-search-hit" || name == "frozen-search-miss" || name == "frozen-search-batch") {
+        FrozenCatalog frozen = tree.freeze();
+        if (name == "frozen-search-batch") {
+            std::vector<const Course*> results;
+            return measure(name, data, options, "ns/op", lookups, [&]() {
+                auto start = Clock::now();
+                frozen.searchBatch(data.hitKeys, results);
+                double ns = elapsedNs(start);
+                benchmarkSink = results.size();
+                return ns;
+            });
+        }
+        const std::vector<std::string>& keys = name == "frozen-search-hit" ? data.hitKeys : data.missKeys;
+        return measure(name, data, options, "ns/op", lookups, [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (const auto& key : keys) {
+                if (frozen.search(key))
+                    ++found;
+            }
+            double ns = elapsedNs(start);
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+    if (name == "traversal") {
+        // Visits every course without printing, so the timing is the walk rather than std::cout.
+        return measure(name, data, options, "ns/op", n, [&]() {
+            std::size_t bytes = 0;
+            auto start = Clock::now();
+            tree.forEachInOrder([&](const Course& course) { bytes += course.courseNumber.size(); });
+            double ns = elapsedNs(start);
+            benchmarkSink = bytes;
+            return ns;
+        });
+    }
+    if (name == "schedule") {
+        return measure(name, data, options, "ns/op", n, [&]() {
+            auto start = Clock::now();
+            PrerequisiteGraph graph;
+            graph.build(tree);
+            DegreePlan plan = DegreePlanner(graph).plan();
+            double ns = elapsedNs(start);
+            benchmarkSink = plan.termCount();
+            return ns;
+        });
+    }
+    if (name == "eligible" || name == "eligible-batch") {
+        PrerequisiteGraph graph;
+        graph.build(tree);
+        EligibilityEngine engine(graph);
+        std::vector<std::vector<std::uint32_t>> students = makeStudents(graph, options);
+        if (name == "eligible") {
+            std::vector<EligibilityEngine::Bitset> completed;
+            for (const auto& student : students)
+                completed.push_back(engine.completedSet(student));
+            return measure(name, data, options, "ns/op", static_cast<double>(students.size()), [&]() {
+                std::size_t found = 0;
+                auto start = Clock::now();
+                for (const auto& set : completed)
+                    found += engine.eligibleSet(set).size();
+                double ns = elapsedNs(start);
+                benchmarkSink = found;
+                return ns;
+            });
+        }
+        return measure(name, data, options, "ns/op", static_cast<double>(students.size()), [&]() {
+            auto start = Clock::now();
+            EligibilityBatch batch = engine.eligibleBatch(students, options.threads);
+            double ns = elapsedNs(start);
+            benchmarkSink = batch.words.size();
+            return ns;
+        });
+    }
+
+    if (name == "closure-tree" || name == "closure-graph" || name == "closure-cold" || name == "closure-warm" ||
+        name == "closure-invalidate") {
+        ClosureWorkload workload = makeClosureWorkload(data);
+        const double queries = static_cast<double>(workload.queries.size());
+        RedBlackTree chains;
+        chains.bulkLoad(std::vector<Course>(workload.courses));
+        if (name == "closure-tree") {
+            // What callers do without a cache: expand prerequisites with a lookup per name.
+            return measure(name, data, options, "ns/op", queries, [&]() {
+                std::size_t found = 0;
+                std::unordered_set<std::string> seen;
+                std::vector<const Course*> stack;
+                auto start = Clock::now();
+                for (const auto& key : workload.queries) {
+                    seen.clear();
+                    stack.assign(1, chains.find(key));
+                    while (!stack.empty()) {
+                        const Course* course = stack.back();
+                        stack.pop_back();
+                        for (const auto& prereq : course->prerequisites) {
+                            if (seen.insert(prereq).second) {
+                                if (const Course* next = chains.find(prereq))
+                                    stack.push_back(next);
+                            }
+                        }
+                    }
+                    found += seen.size();
+                }
+                double ns = elapsedNs(start);
+                benchmarkSink = found;
+                return ns;
+            });
+        }
+        if (name == "closure-graph") {
+            PrerequisiteGraph graph;
+            graph.build(chains);
+            PrerequisiteGraph::VisitMarks marks;
+            std::vector<std::uint32_t> chain;
+            return measure(name, data, options, "ns/op", queries, [&]() {
+                std::size_t found = 0;
+                auto start = Clock::now();
+                for (const auto& key : workload.queries) {
+                    graph.allPrerequisites(graph.idOf(key), marks, chain);
+                    found += chain.size();
+                }
+                double ns = elapsedNs(start);
+                benchmarkSink = found;
+                return ns;
+            });
+        }
+        if (name == "closure-cold") {
+            // A fresh cache per trial: the first query in each run computes the run's closures.
+            return measure(name, data, options, "ns/op", queries, [&]() {
+                ClosureCache cache;
+                chains.addObserver(&cache);
+                std::size_t found = 0;
+                std::vector<const Course*> closure;
+                auto start = Clock::now();
+                for (const auto& key : workload.queries) {
+                    closure.clear();
+                    cache.allPrerequisites(key, closure);
+                    found += closure.size();
+                }
+                double ns = elapsedNs(start);
+                chains.removeObserver(&cache);
+                benchmarkSink = found;
+                return ns;
+            });
+        }
+        ClosureCache cache;
+        chains.addObserver(&cache);
+        for (const auto& key : workload.queries)
+            cache.closureSize(key);
+        if (name == "closure-warm") {
+            return measure(name, data, options, "ns/op", queries, [&]() {
+                std::size_t found = 0;
+                std::vector<const Course*> closure;
+                auto start = Clock::now();
+                for (const auto& key : workload.queries) {
+                    closure.clear();
+                    cache.allPrerequisites(key, closure);
+                    found += closure.size();
+                }
+                double ns = elapsedNs(start);
+                benchmarkSink = found;
+                return ns;
+            });
+        }
+        // closure-invalidate: each operation replaces a course with its prerequisites dropped
+        // or restored, then asks for the closure of the last course in its run.
+        std::vector<std::size_t> ranks;
+        for (const auto& key : workload.queries) {
+            auto it = std::lower_bound(workload.courses.begin(), workload.courses.end(), key,
+                                       [](const Course& course, const std::string& k) { return course.courseNumber < k; });
+            ranks.push_back(static_cast<std::size_t>(it - workload.courses.begin()));
+        }
+        bool restore = false;
+        return measure(name, data, options, "ns/op", queries, [&]() {
+            std::size_t found = 0;
+            auto start = Clock::now();
+            for (std::size_t rank : ranks) {
+                const Course& original = workload.courses[rank];
+                chains.upsert(restore ? Course(original) : Course(original.courseNumber, original.courseTitle));
+                std::size_t last = std::min(workload.courses.size(), (rank / 64 + 1) * 64) - 1;
+                found += cache.closureSize(workload.courses[last].courseNumber);
+            }
+            double ns = elapsedNs(start);
+            restore = !restore;
+            benchmarkSink = found;
+            return ns;
+        });
+    }
+
+    // snapshot-read and snapshot-read-writer
+    SnapshotTree snapshots;
+    snapshots.assign(tree);
+    bool withWriter = name == "snapshot-read-writer";
+    std::size_t perReader = std::max<std::size_t>(1, data.hitKeys.size() / options.threads);
+    return measure(name, data, options, "ns/op", static_cast<double>(perReader * options.threads), [&]() {
+        return snapshotReadTrial(snapshots, data, options.threads, perReader, withWriter);
+    });
+}
+
+struct Summary {
+    double min, p50, p90, p99, max, mean, stddev;
+};
+
+/*
+* summarize: Nearest-rank percentiles, mean and sample standard deviation over the trials.
+*/
+Summary summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+        return samples[std::min(samples.size() - 1, rank == 0 ? 0 : rank - 1)];
+    };
+    Summary s{};
+    s.min = samples.front();
+    s.max = samples.back();
+    s.p50 = percentile(50);
+    s.p90 = percentile(90);
+    s.p99 = percentile(99);
+    for (double v : samples)
+        s.mean += v;
+    s.mean /= static_cast<double>(samples.size());
+    for (double v : samples)
+        s.stddev += (v - s.mean) * (v - s.mean);
+    s.stddev = samples.size() > 1 ? std::sqrt(s.stddev / static_cast<double>(samples.size() - 1)) : 0.0;
+    return s;
+}
+
+// Operations per second at the median, or 0 for non-timing units.
+double opsPerSecond(const Result& result, const Summary& s) {
+    return result.unit == "ns/op" && s.p50 > 0 ? 1e9 / s.p50 : 0.0;
+}
+
+void writeText(std::ostream& out, const std::vector<Result>& results) {
+    out << std::left << std::setw(22) << "case" << std::setw(13) << "distribution" << std::right
+        << std::setw(10) << "size" << std::setw(14) << "unit" << std::setw(12) << "p50"
+        << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12) << "min"
+        << std::setw(12) << "max" << std::setw(14) << "ops/s" << "\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& result : results) {
+        Summary s = summarize(result.samples);
+        out << std::left << std::setw(22) << result.caseName << std::setw(13) << result.distribution << std::right
+            << std::setw(10) << result.size << std::setw(14) << result.unit << std::setw(12) << s.p50
+            << std::setw(12) << s.p90 << std::setw(12) << s.p99 << std::setw(12) << s.min
+            << std::setw(12) << s.max << std::setw(14) << std::setprecision(0) << opsPerSecond(result, s)
+            << std::setprecision(1) << "\n";
+    }
+}
+
+void writeCsv(std::ostream& out, const std::vector<Result>& results) {
+    out << "case,distribution,size,unit,trials,min,p50,p90,p99,max,mean,stddev,ops_per_second\n";
+    out << std::setprecision(10);
+    for (const auto& result : results) {
+        Summary s = summarize(result.samples);
+        out << result.caseName << "," << result.distribution << "," << result.size << "," << result.unit << ","
+            << result.samples.size() << "," << s.min << "," << s.p50 << "," << s.p90 << "," << s.p99 << ","
+            << s.max << "," << s.mean << "," << s.stddev << "," << opsPerSecond(result, s) << "\n";
+    }
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+    out << std::setprecision(10);
+    out << "{\n  \"benchmark\": \"CatalogBenchmark\",\n"
+        << "  \"trials\": " << options.trials << ",\n  \"warmup\": " << options.warmup << ",\n"
+        << "  \"lookups\": " << options.lookups << ",\n  \"threads\": " << options.threads << ",\n"
+        << "  \"seed\": " << options.seed << ",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        Summary s = summarize(result.samples);
+        out << (i ? ",\n" : "\n") << "    {\"case\": \"" << result.caseName << "\", \"distribution\": \""
+            << result.distribution << "\", \"size\": " << result.size << ", \"unit\": \"" << result.unit << "\", "
+            << "\"min\": " << s.min << ", \"p50\": " << s.p50 << ", \"p90\": " << s.p90 << ", \"p99\": " << s.p99
+            << ", \"max\": " << s.max << ", \"mean\": " << s.mean << ", \"stddev\": " << s.stddev
+            << ", \"opsPerSecond\": " << opsPerSecond(result, s) << ", \"samples\": [";
+        for (std::size_t j = 0; j < result.samples.size(); ++j)
+            out << (j ? ", " : "") << result.samples[j];
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+    std::vector<std::string> cases = options.cases;
+    if (cases.empty())
+        cases.assign(std::begin(allCases), std::end(allCases));
+
+    std::vector<Result> results;
+    try {
+        for (std::size_t size : options.sizes) {
+            if (size == 0)
+                continue;
+            for (const auto& distribution : options.distributions) {
+                std::cerr << "Generating " << size << " " << distribution << " courses...\n";
+                Dataset data = makeDataset(distribution, size, options);
+                for (const auto& name : cases) {
+                    std::cerr << "  " << name << "\n";
+                    results.push_back(runCase(name, data, options));
+                }
+                std::error_code ignored;
+                std::filesystem::remove(data.csvPath, ignored);
+                std::filesystem::remove(data.csvPath + ".snap", ignored);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Error: Could not open " << options.output << " for writing\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    if (options.format == "json")
+        writeJson(out, results, options);
+    else if (options.format == "csv")
+        writeCsv(out, results);
+    else
+        writeText(out, results);
+    return 0;
+}
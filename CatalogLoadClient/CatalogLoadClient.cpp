@@ -0,0 +1,374 @@
+/*
+    File: CatalogLoadClient.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Load generator for the catalog server's socket mode. Opens several connections,
+                 keeps a fixed number of pipelined requests in flight on each, and reports
+                 throughput and latency percentiles. Usage: CatalogLoadClient --socket PATH
+                 --catalog FILE [options] (see --help)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../CSCourseTree/CsvLoader.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string socketPath;
+        std::string catalog = "../CSCourseTree/ABCUCourses.txt";
+        unsigned connections = 4;
+        std::size_t requests = 200000;      // in total, across all connections
+        std::size_t pipeline = 32;          // requests in flight per connection
+        unsigned lookupWeight = 80;
+        unsigned rangeWeight = 15;
+        unsigned prereqsWeight = 5;
+        std::size_t rangeSize = 10;
+        unsigned seed = 42;
+    };
+
+    // What one connection measured.
+    struct ConnectionResult {
+        std::vector<double> latencies;      // microseconds, one per answered request
+        std::size_t errors = 0;             // ERR responses
+        bool failed = false;                // the connection broke before finishing
+    };
+
+    void usage(const char* program) {
+        std::cerr
+            << "Usage: " << program << " --socket PATH [options]\n"
+            << "Sends pipelined requests to a catalog server started with --serve --socket PATH.\n"
+            << "  --socket PATH           server's Unix domain socket (required)\n"
+            << "  --catalog FILE          catalog the server loaded; request keys come from it\n"
+            << "                          (default: ../CSCourseTree/ABCUCourses.txt)\n"
+            << "  --connections N         concurrent connections, one thread each (default: 4)\n"
+            << "  --requests N            requests in total (default: 200000)\n"
+            << "  --pipeline N            requests in flight per connection (default: 32)\n"
+            << "  --mix L,R,P             percentage weights of LOOKUP, RANGE and PREREQS (default: 80,15,5)\n"
+            << "  --range-size N          limit on each RANGE request (default: 10)\n"
+            << "  --seed N                random seed (default: 42)\n";
+    }
+
+    std::vector<std::string> splitList(const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+        return items;
+    }
+
+    /*
+    * parseOptions: Reads --name value pairs. Returns false (after printing usage) on any error.
+    */
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        try {
+            for (int i = 1; i < argc; ++i) {
+                std::string name = argv[i];
+                if (name == "--help" || name == "-h") {
+                    usage(argv[0]);
+                    return false;
+                }
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("missing value for " + name);
+                std::string value = argv[++i];
+                if (name == "--socket")
+                    options.socketPath = value;
+                else if (name == "--catalog")
+                    options.catalog = value;
+                else if (name == "--connections")
+                    options.connections = static_cast<unsigned>(std::max(1, std::stoi(value)));
+                else if (name == "--requests")
+                    options.requests = std::max<std::size_t>(1, std::stoull(value));
+                else if (name == "--pipeline")
+                    options.pipeline = std::max<std::size_t>(1, std::stoull(value));
+                else if (name == "--mix") {
+                    std::vector<std::string> weights = splitList(value);
+                    if (weights.size() != 3)
+                        throw std::invalid_argument("--mix takes three weights");
+                    options.lookupWeight = static_cast<unsigned>(std::stoul(weights[0]));
+                    options.rangeWeight = static_cast<unsigned>(std::stoul(weights[1]));
+                    options.prereqsWeight = static_cast<unsigned>(std::stoul(weights[2]));
+                    if (options.lookupWeight + options.rangeWeight + options.prereqsWeight == 0)
+                        throw std::invalid_argument("--mix weights are all zero");
+                }
+                else if (name == "--range-size")
+                    options.rangeSize = std::max<std::size_t>(1, std::stoull(value));
+                else if (name == "--seed")
+                    options.seed = static_cast<unsigned>(std::stoul(value));
+                else
+                    throw std::invalid_argument("unknown option " + name);
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            usage(argv[0]);
+            return false;
+        }
+        if (options.socketPath.empty()) {
+            std::cerr << "Error: --socket is required\n";
+            usage(argv[0]);
+            return false;
+        }
+        return true;
+    }
+
+    // Sorted, distinct course numbers from the catalog, so requests mostly hit.
+    std::vector<std::string> loadKeys(const std::string& fileName) {
+        std::vector<std::string> keys;
+        MappedFile file;
+        if (!file.open(fileName)) {
+            std::cerr << "Failed to open the file: " << fileName << std::endl;
+            return keys;
+        }
+        std::vector<Course> courses;
+        std::vector<CsvParseError> errors;
+        parseCourseCsvParallel(file.view(), courses, errors);
+        keys.reserve(courses.size());
+        for (auto& course : courses)
+            keys.push_back(std::move(course.courseNumber));
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+
+    // Appends one request line drawn from the mix.
+    void appendRequest(std::string& out, const Options& options, const std::vector<std::string>& keys,
+                       std::mt19937& rng) {
+        std::uniform_int_distribution<unsigned> pickKind(0, options.lookupWeight + options.rangeWeight + options.prereqsWeight - 1);
+        std::uniform_int_distribution<std::size_t> pickKey(0, keys.size() - 1);
+        unsigned kind = pickKind(rng);
+        std::size_t index = pickKey(rng);
+        if (kind < options.lookupWeight) {
+            out += "LOOKUP ";
+            out += keys[index];
+        }
+        else if (kind < options.lookupWeight + options.rangeWeight) {
+            // Upper bound a little past the limit, so the limit decides the response size.
+            std::size_t last = std::min(keys.size() - 1, index + options.rangeSize);
+            out += "RANGE ";
+            out += keys[index];
+            out += ' ';
+            out += last > index ? keys[last] : keys[index] + "~";
+            out += ' ';
+            out += std::to_string(options.rangeSize);
+        }
+        else {
+            out += "PREREQS ";
+            out += keys[index];
+        }
+        out += '\n';
+    }
+
+    /*
+    * ResponseReader: Splits the server's output into responses: an "OK <count>" header and
+    *                 count record lines, or a single "ERR" line. Lines may arrive in any split.
+    */
+    class ResponseReader {
+    public:
+        // Consumes data; calls done(isError) once per complete response.
+        template <typename Done>
+        bool feed(const char* data, std::size_t size, Done&& done) {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (data[i] != '\n') {
+                    if (recordsLeft == 0 && line.size() < 32)
+                        line += data[i];    // only header lines are kept
+                    continue;
+                }
+                if (recordsLeft > 0) {
+                    if (--recordsLeft == 0)
+                        done(false);
+                    continue;
+                }
+                if (line.compare(0, 3, "OK ") == 0) {
+                    std::size_t count = std::stoull(line.substr(3));
+                    if (count == 0)
+                        done(false);
+                    recordsLeft = count;
+                }
+                else if (line.compare(0, 4, "ERR ") == 0) {
+                    done(true);
+                }
+                else {
+                    return false;
+                }
+                line.clear();
+            }
+            return true;
+        }
+
+    private:
+        std::string line;
+        std::size_t recordsLeft = 0;
+    };
+
+#ifndef _WIN32
+    int connectTo(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+            return -1;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        return fd;
+    }
+
+    /*
+    * runConnection: Closed loop with a window of options.pipeline requests. Whenever the window
+    *                has room, the missing requests go out in one write; each response's latency
+    *                is measured from the moment its request was written.
+    */
+    ConnectionResult runConnection(const Options& options, const std::vector<std::string>& keys,
+                                   std::size_t requests, unsigned seed) {
+        ConnectionResult result;
+        result.latencies.reserve(requests);
+        int fd = connectTo(options.socketPath);
+        if (fd < 0) {
+            result.failed = true;
+            return result;
+        }
+        std::mt19937 rng(seed);
+        std::deque<Clock::time_point> inFlight;
+        ResponseReader reader;
+        std::string batch;
+        std::vector<char> buffer(64 * 1024);
+        std::size_t sent = 0;
+        while (result.latencies.size() < requests) {
+            batch.clear();
+            std::size_t added = 0;
+            while (sent + added < requests && inFlight.size() + added < options.pipeline) {
+                appendRequest(batch, options, keys, rng);
+                ++added;
+            }
+            if (added > 0) {
+                std::string_view pending(batch);
+                while (!pending.empty()) {
+                    ssize_t n = ::write(fd, pending.data(), pending.size());
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n <= 0) {
+                        result.failed = true;
+                        ::close(fd);
+                        return result;
+                    }
+                    pending.remove_prefix(static_cast<std::size_t>(n));
+                }
+                inFlight.insert(inFlight.end(), added, Clock::now());
+                sent += added;
+            }
+
+            ssize_t n = ::read(fd, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR)
+                continue;
+            Clock::time_point now = Clock::now();
+            bool ok = n > 0 && reader.feed(buffer.data(), static_cast<std::size_t>(n), [&](bool isError) {
+                if (inFlight.empty())
+                    return;
+                result.latencies.push_back(std::chrono::duration<double, std::micro>(now - inFlight.front()).count());
+                inFlight.pop_front();
+                if (isError)
+                    ++result.errors;
+            });
+            if (!ok) {
+                result.failed = true;
+                break;
+            }
+        }
+        ::close(fd);
+        return result;
+    }
+#endif
+
+    // Nearest-rank percentile of sorted samples.
+    double percentile(const std::vector<double>& sorted, double p) {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+    }
+}
+
+int main(int argc, char* argv[]) {
+#ifdef _WIN32
+    (void)argc;
+    (void)argv;
+    std::cerr << "CatalogLoadClient needs Unix domain sockets, which this platform does not support." << std::endl;
+    return 1;
+#else
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+    std::vector<std::string> keys = loadKeys(options.catalog);
+    if (keys.empty()) {
+        std::cerr << "Error: No course numbers were loaded from " << options.catalog << std::endl;
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<ConnectionResult> results(options.connections);
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (unsigned c = 0; c < options.connections; ++c) {
+        // Spread the requests evenly; the first connections take the remainder.
+        std::size_t share = options.requests / options.connections + (c < options.requests % options.connections ? 1 : 0);
+        threads.emplace_back([&, c, share]() {
+            results[c] = runConnection(options, keys, share, options.seed + c);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    std::size_t errors = 0;
+    unsigned failed = 0;
+    for (auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+        failed += result.failed ? 1 : 0;
+    }
+    if (failed > 0)
+        std::cerr << "Warning: " << failed << " of " << options.connections
+                  << " connections failed (is the server running on " << options.socketPath << "?)" << std::endl;
+    if (latencies.empty())
+        return 1;
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "requests     " << latencies.size() << " over " << options.connections << " connections, pipeline "
+              << options.pipeline << "\n"
+              << "elapsed      " << std::setprecision(3) << seconds << " s\n"
+              << "throughput   " << std::setprecision(0) << static_cast<double>(latencies.size()) / seconds << " req/s\n"
+              << "errors       " << errors << "\n"
+              << std::setprecision(1)
+              << "latency (us) p50 " << percentile(latencies, 50) << "  p90 " << percentile(latencies, 90)
+              << "  p99 " << percentile(latencies, 99) << "  p99.9 " << percentile(latencies, 99.9)
+              << "  max " << latencies.back() << std::endl;
+    return failed > 0 ? 1 : 0;
+#endif
+}
@@ -0,0 +1,40 @@
+/*
+    File: CatalogSnapshotTool.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Converts a course CSV file into a binary catalog snapshot that CatalogSnapshot
+                 can map at startup. Usage: CatalogSnapshotTool [input.csv] [output.snap]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../CSCourseTree/CatalogSnapshot.h"
+#include "../CSCourseTree/Course.h"
+
+int main(int argc, char* argv[]) {
+    std::string input = argc > 1 ? argv[1] : "../CSCourseTree/ABCUCourses.txt";
+    std::string output = argc > 2 ? argv[2] : "../CSCourseTree/ABCUCourses.snap";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    RedBlackTree tree;
+    tree.loadDataStructure(input);
+    if (tree.size() == 0) {
+        std::cerr << "Error: No courses were loaded from " << input << std::endl;
+        return 1;
+    }
+    if (!writeCatalogSnapshot(tree, output))
+        return 1;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Read the file back so a bad write is caught here rather than at the next startup.
+    CatalogSnapshot snapshot;
+    if (!snapshot.open(output) || snapshot.size() != tree.size()) {
+        std::cerr << "Error: " << output << " did not verify after writing" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << snapshot.size() << " courses to " << output << " in "
+              << std::chrono::duration<double>(end - start).count() << " seconds." << std::endl;
+    return 0;
+}
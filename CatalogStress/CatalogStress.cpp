@@ -0,0 +1,777 @@
+/*
+    File: CatalogStress.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Differential stress test and benchmark for the catalog's tree. Replays the same
+                 seeded operation streams against RedBlackTree, the generic tree with compact
+                 nodes, std::map, std::unordered_map and a sorted std::vector; checks every
+                 result against a reference model and the trees' red-black invariants, and
+                 reports throughput, memory and height for each. Run with --help for the options.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../CSCourseTree/BasicRedBlackTree.h"
+#include "../CSCourseTree/Course.h"
+
+/*
+* Heap accounting: every global new/delete in this program goes through these replacements,
+* which keep a running total of live bytes so each container's memory can be measured exactly.
+*/
+namespace {
+    std::atomic<long long> liveHeapBytes{ 0 };
+    constexpr std::size_t allocationHeader = 16;    // keeps the default new alignment
+}
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + allocationHeader);
+    if (!block)
+        throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    liveHeapBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + allocationHeader;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer)
+        return;
+    // Integer arithmetic: GCC's bounds checker flags pointer arithmetic before an object's start.
+    void* block = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(pointer) - allocationHeader);
+    liveHeapBytes.fetch_sub(static_cast<long long>(*static_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const allContainers[] = { "tree", "compact", "map", "unordered", "vector" };
+const char* const allOrders[] = { "sorted", "reversed", "zigzag", "random" };
+const char* const allLookups[] = { "uniform", "zipfian" };
+
+struct Options {
+    std::size_t size = 100000;
+    std::size_t lookups = 200000;
+    std::size_t churn = 10000;
+    std::vector<std::string> containers{ std::begin(allContainers), std::end(allContainers) };
+    std::vector<std::string> orders{ std::begin(allOrders), std::end(allOrders) };
+    std::vector<std::string> lookupDistributions{ std::begin(allLookups), std::end(allLookups) };
+    std::vector<unsigned> hitRatios{ 90, 10 };
+    double zipfExponent = 0.99;
+    std::size_t checkEvery = 0;             // churn operations between invariant checks (0 = per phase)
+    unsigned rounds = 1;
+    unsigned seed = 42;
+    std::string format = "text";
+    std::string output;
+};
+
+/*
+* Stream: One workload, replayed identically against every container. Keys are indexes into
+*         keys, which is sorted; even indexes are loaded at the start and odd ones are absent
+*         (each sits between two loaded keys, so a miss descends as far as a hit). The expected
+*         results come from a reference model that works on key indexes, not strings.
+*/
+enum class OpKind : std::uint8_t { Find, Erase, Upsert };
+
+struct Op {
+    OpKind kind;
+    std::uint32_t key;
+};
+
+struct Stream {
+    std::string order;
+    std::string lookup;
+    unsigned hitRatio = 0;
+    std::vector<std::string> keys;
+    std::vector<std::uint32_t> loads;           // the even keys, in insert order
+    std::vector<Course> loadCourses;            // loads[i]'s course
+    std::vector<std::uint32_t> lookups;
+    std::vector<Op> churn;
+    std::vector<Course> churnCourses;           // the course each Upsert stores (empty for others)
+
+    std::vector<std::uint64_t> expectedLookups;
+    std::vector<std::uint64_t> expectedChurn;
+    std::vector<std::uint32_t> finalKeys;       // contents after the churn, in order
+    std::vector<std::string> finalTitles;
+};
+
+// What one container did on one stream.
+struct Measurement {
+    double insertNs = 0;                        // per operation
+    double lookupNs = 0;
+    double churnNs = 0;
+    double bytesPerEntry = 0;
+    std::size_t height = 0;                     // 0 when the container has no tree shape
+    std::size_t mismatches = 0;
+    std::string problem;                        // first invariant violation, if any
+};
+
+// All rounds of one container on one workload.
+struct Result {
+    std::string order;
+    std::string lookup;
+    unsigned hitRatio = 0;
+    std::string container;
+    std::vector<Measurement> rounds;
+};
+
+/*
+* usage: Prints the command-line options.
+*/
+void usage(const char* program) {
+    auto list = [](const char* const* first, const char* const* last) {
+        std::string text;
+        for (; first != last; ++first)
+            text += std::string(text.empty() ? "" : ",") + *first;
+        return text;
+    };
+    std::cerr << "Usage: " << program << " [options]\n"
+        << "Replays the same operation streams against the catalog tree and standard containers,\n"
+        << "verifies every result and the red-black invariants, and reports throughput, memory and height.\n"
+        << "  --size N                courses loaded before the lookups (default 100000)\n"
+        << "  --lookups N             lookups in the read-only phase (default 200000)\n"
+        << "  --churn N               mixed finds, erases and upserts afterwards (default 10000)\n"
+        << "  --containers a,b        " << list(std::begin(allContainers), std::end(allContainers)) << " (default all)\n"
+        << "  --orders a,b            insert orders: " << list(std::begin(allOrders), std::end(allOrders)) << " (default all)\n"
+        << "  --lookup-distributions a,b\n"
+        << "                          key popularity: " << list(std::begin(allLookups), std::end(allLookups)) << " (default both)\n"
+        << "  --hit-ratios N,N        percentage of lookups for stored keys (default 90,10)\n"
+        << "  --zipf-exponent X       skew of the zipfian distribution (default 0.99)\n"
+        << "  --check-every N         also check invariants every N churn operations (default: per phase)\n"
+        << "  --rounds N              repeat with seeds seed, seed+1, ...; throughput is the median (default 1)\n"
+        << "  --seed N                random seed (default 42)\n"
+        << "  --format text|csv       output format (default text)\n"
+        << "  --output FILE           write results to FILE instead of stdout\n"
+        << "The exit status is 1 if any result or invariant check failed.\n";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+// Every name must be one of known.
+template <std::size_t N>
+void checkNames(const std::vector<std::string>& names, const char* const (&known)[N], const char* what) {
+    for (const auto& name : names) {
+        if (std::find(std::begin(known), std::end(known), name) == std::end(known))
+            throw std::invalid_argument(std::string("unknown ") + what + " " + name);
+    }
+}
+
+/*
+* parseOptions: Reads --name value pairs. Returns false (after printing usage) on any error.
+*/
+bool parseOptions(int argc, char* argv[], Options& options) {
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string name = argv[i];
+            if (name == "--help" || name == "-h") {
+                usage(argv[0]);
+                return false;
+            }
+            if (i + 1 >= argc)
+                throw std::invalid_argument("missing value for " + name);
+            std::string value = argv[++i];
+            if (name == "--size")
+                options.size = std::max<std::size_t>(1, std::stoull(value));
+            else if (name == "--lookups")
+                options.lookups = std::stoull(value);
+            else if (name == "--churn")
+                options.churn = std::stoull(value);
+            else if (name == "--containers")
+                options.containers = splitList(value);
+            else if (name == "--orders")
+                options.orders = splitList(value);
+            else if (name == "--lookup-distributions")
+                options.lookupDistributions = splitList(value);
+            else if (name == "--hit-ratios") {
+                options.hitRatios.clear();
+                for (const auto& item : splitList(value))
+                    options.hitRatios.push_back(std::min(100u, static_cast<unsigned>(std::stoul(item))));
+            }
+            else if (name == "--zipf-exponent")
+                options.zipfExponent = std::stod(value);
+            else if (name == "--check-every")
+                options.checkEvery = std::stoull(value);
+            else if (name == "--rounds")
+                options.rounds = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+            else if (name == "--seed")
+                options.seed = static_cast<unsigned>(std::stoul(value));
+            else if (name == "--format")
+                options.format = value;
+            else if (name == "--output")
+                options.output = value;
+            else
+                throw std::invalid_argument("unknown option " + name);
+        }
+        checkNames(options.containers, allContainers, "container");
+        checkNames(options.orders, allOrders, "order");
+        checkNames(options.lookupDistributions, allLookups, "lookup distribution");
+        if (options.format != "text" && options.format != "csv")
+            throw std::invalid_argument("unknown format " + options.format);
+        if (options.size > UINT32_MAX / 2)
+            throw std::invalid_argument("--size is too large");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+/*
+* makeKeys: count distinct course numbers, sorted. Departments of 2 to 7 letters with
+*           zero-padded numbers give keys of 7 to 13 characters, so both the packed-prefix
+*           comparisons and the full-string fallback are exercised.
+*/
+std::vector<std::string> makeKeys(std::size_t count) {
+    static const char* const departments[] = {
+        "CS", "CSCI", "MATH", "PHYS", "CHEM", "BIO", "ENGL", "HIST", "ECON", "PSYC",
+        "PHIL", "ART", "MUS", "SOC", "STAT", "GEOG", "LING", "ASTR", "NURS", "EDUC",
+        "BIOCHEM", "ANTHRO", "ECE", "MECHENG", "CIVENG", "JOURNAL", "THEATRE", "COMPLIT"
+    };
+    const std::size_t departmentCount = sizeof(departments) / sizeof(departments[0]);
+    const std::size_t perDepartment = (count + departmentCount - 1) / departmentCount;
+    const std::size_t digits = std::max<std::size_t>(5, std::to_string(perDepartment).size());
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string number = std::to_string(i / departmentCount);
+        keys.push_back(departments[i % departmentCount] + std::string(digits - number.size(), '0') + number);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+/*
+* insertOrder: The loaded keys 0, 2, 4, ... in the requested order. Sorted and reversed input
+*              always insert at the same edge of the tree, and zigzag (smallest, largest, next
+*              smallest, ...) alternates between both edges; all three drive insertFixup's
+*              rotations far harder than random input does.
+*/
+std::vector<std::uint32_t> insertOrder(const std::string& order, std::size_t size, std::mt19937_64& rng) {
+    std::vector<std::uint32_t> loads(size);
+    for (std::size_t i = 0; i < size; ++i)
+        loads[i] = static_cast<std::uint32_t>(2 * i);
+    if (order == "reversed") {
+        std::reverse(loads.begin(), loads.end());
+    }
+    else if (order == "zigzag") {
+        std::vector<std::uint32_t> zigzag;
+        zigzag.reserve(size);
+        for (std::size_t lo = 0, hi = size; lo < hi;) {
+            zigzag.push_back(loads[lo++]);
+            if (lo < hi)
+                zigzag.push_back(loads[--hi]);
+        }
+        loads.swap(zigzag);
+    }
+    else if (order == "random") {
+        std::shuffle(loads.begin(), loads.end(), rng);
+    }
+    return loads;
+}
+
+/*
+* KeyPicker: Draws lookup keys. A hit is a loaded (even) key, chosen uniformly or by a zipfian
+*            rank over a random permutation of them, so the popular keys are spread across the
+*            tree instead of clustered at one end; a miss is a uniformly chosen odd key.
+*/
+class KeyPicker {
+public:
+    KeyPicker(const Options& options, const std::string& distribution, unsigned hitRatio, std::mt19937_64& rng)
+        : rng(rng), size(options.size), hitRatio(hitRatio), zipfian(distribution == "zipfian") {
+        if (!zipfian)
+            return;
+        popularity.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+            popularity[i] = static_cast<std::uint32_t>(i);
+        std::shuffle(popularity.begin(), popularity.end(), rng);
+        cumulative.resize(size);
+        double total = 0;
+        for (std::size_t rank = 0; rank < size; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), options.zipfExponent);
+            cumulative[rank] = total;
+        }
+    }
+
+    std::uint32_t hit() {
+        std::size_t i;
+        if (zipfian) {
+            double u = std::uniform_real_distribution<double>(0.0, cumulative.back())(rng);
+            std::size_t rank = static_cast<std::size_t>(std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin());
+            i = popularity[std::min(rank, size - 1)];
+        }
+        else {
+            i = rng() % size;
+        }
+        return static_cast<std::uint32_t>(2 * i);
+    }
+
+    std::uint32_t miss() { return static_cast<std::uint32_t>(2 * (rng() % size) + 1); }
+
+    std::uint32_t lookup() { return rng() % 100 < hitRatio ? hit() : miss(); }
+
+private:
+    std::mt19937_64& rng;
+    std::size_t size;
+    unsigned hitRatio;
+    bool zipfian;
+    std::vector<std::uint32_t> popularity;      // rank -> loaded key (as i, key 2i)
+    std::vector<double> cumulative;             // running sum of 1 / rank^s
+};
+
+// A found course's result: its title's hash (never 0). A miss is 0.
+std::uint64_t titleCode(const Course* course) {
+    return course ? (std::hash<std::string>()(course->courseTitle) | 1) : 0;
+}
+
+/*
+* makeStream: Builds the three phases and runs them on the reference model. The churn is 40%
+*             finds (same key mix as the lookups), 20% erases and 20% upserts of loaded keys
+*             (hits or re-inserts, depending on what the stream erased before), and 20% upserts
+*             of absent keys, which insert them.
+*/
+Stream makeStream(const Options& options, const std::string& order, const std::string& lookup, unsigned hitRatio,
+                  unsigned seed) {
+    std::mt19937_64 rng(seed);
+    Stream stream;
+    stream.order = order;
+    stream.lookup = lookup;
+    stream.hitRatio = hitRatio;
+    stream.keys = makeKeys(2 * options.size);
+    stream.loads = insertOrder(order, options.size, rng);
+
+    std::map<std::uint32_t, std::string> model;
+    stream.loadCourses.reserve(options.size);
+    for (std::uint32_t key : stream.loads) {
+        std::string title = "Course Title for " + stream.keys[key];
+        stream.loadCourses.emplace_back(stream.keys[key], title);
+        model[key] = title;
+    }
+
+    KeyPicker picker(options, lookup, hitRatio, rng);
+    auto expectFind = [&](std::uint32_t key) {
+        auto it = model.find(key);
+        return it == model.end() ? 0 : (std::hash<std::string>()(it->second) | 1);
+    };
+    stream.lookups.resize(options.lookups);
+    stream.expectedLookups.resize(options.lookups);
+    for (std::size_t i = 0; i < options.lookups; ++i) {
+        stream.lookups[i] = picker.lookup();
+        stream.expectedLookups[i] = expectFind(stream.lookups[i]);
+    }
+
+    stream.churn.resize(options.churn);
+    stream.churnCourses.resize(options.churn);
+    stream.expectedChurn.resize(options.churn);
+    for (std::size_t i = 0; i < options.churn; ++i) {
+        unsigned roll = static_cast<unsigned>(rng() % 10);
+        Op& op = stream.churn[i];
+        if (roll < 4) {
+            op = { OpKind::Find, picker.lookup() };
+            stream.expectedChurn[i] = expectFind(op.key);
+        }
+        else if (roll < 6) {
+            op = { OpKind::Erase, picker.hit() };
+            stream.expectedChurn[i] = model.erase(op.key);
+        }
+        else {
+            op = { OpKind::Upsert, roll < 8 ? picker.hit() : picker.miss() };
+            std::string title = "Revision " + std::to_string(i) + " of " + stream.keys[op.key];
+            stream.churnCourses[i] = Course(stream.keys[op.key], title);
+            stream.expectedChurn[i] = model.count(op.key) == 0;
+            model[op.key] = title;
+        }
+    }
+
+    for (const auto& [key, title] : model) {
+        stream.finalKeys.push_back(key);
+        stream.finalTitles.push_back(title);
+    }
+    return stream;
+}
+
+/*
+* Containers: Each adapter gives its container the same five operations. insert is only
+* used for the initial load, where keys are distinct; finishLoad runs once after it.
+*/
+
+// The catalog's own tree: packed keys, parent links and subtree sizes.
+struct CatalogContainer {
+    static constexpr bool ordered = true;
+    RedBlackTree tree;
+
+    void insert(Course&& course) { tree.insert(std::move(course)); }
+    void finishLoad() {}
+    const Course* find(const std::string& number) const { return tree.find(number); }
+    bool erase(const std::string& number) { return tree.erase(number); }
+    bool upsert(Course&& course) { return tree.upsert(std::move(course)); }
+    std::size_t size() const { return tree.size(); }
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const { tree.forEachInOrder(visit); }
+    const char* checkInvariants() const { return tree.checkInvariants(); }
+    std::size_t height() const { return tree.stats().height; }
+};
+
+// The generic tree over plain strings, without parent links or subtree sizes.
+struct CompactContainer {
+    struct NumberOf {
+        const std::string& operator()(const Course& course) const { return course.courseNumber; }
+    };
+    using Tree = BasicRedBlackTree<std::string, Course, NumberOf, std::less<>, std::allocator<Course>, CompactNodes>;
+
+    static constexpr bool ordered = true;
+    Tree tree;
+
+    void insert(Course&& course) { tree.emplace(std::move(course)); }
+    void finishLoad() {}
+    const Course* find(const std::string& number) const { return tree.findValue(number); }
+    bool erase(const std::string& number) { return tree.erase(number); }
+    bool upsert(Course&& course) {
+        if (Course* stored = tree.findValue(course.courseNumber)) {
+            *stored = std::move(course);
+            return false;
+        }
+        tree.emplace(std::move(course));
+        return true;
+    }
+    std::size_t size() const { return tree.size(); }
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const { tree.forEach(visit); }
+    const char* checkInvariants() const { return tree.checkInvariants(); }
+    std::size_t height() const { return tree.height(); }
+};
+
+// std::map and std::unordered_map, keyed by a copy of the course number.
+template <typename Map, bool Ordered>
+struct MapContainer {
+    static constexpr bool ordered = Ordered;
+    Map map;
+
+    void insert(Course&& course) { map.emplace(course.courseNumber, std::move(course)); }
+    void finishLoad() {}
+    const Course* find(const std::string& number) const {
+        auto it = map.find(number);
+        return it == map.end() ? nullptr : &it->second;
+    }
+    bool erase(const std::string& number) { return map.erase(number) != 0; }
+    bool upsert(Course&& course) { return map.insert_or_assign(course.courseNumber, std::move(course)).second; }
+    std::size_t size() const { return map.size(); }
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const auto& entry : map)
+            visit(entry.second);
+    }
+    const char* checkInvariants() const { return nullptr; }
+    std::size_t height() const { return 0; }
+};
+
+/*
+* SortedVectorContainer: Binary search over courses kept in number order. The load appends and
+*                        sorts once at the end, the way a sorted vector is built in practice;
+*                        later inserts and erases shift everything after them, O(n) each.
+*/
+struct SortedVectorContainer {
+    static constexpr bool ordered = true;
+    std::vector<Course> courses;
+
+    static bool byNumber(const Course& course, const std::string& number) { return course.courseNumber < number; }
+
+    std::vector<Course>::iterator position(const std::string& number) {
+        return std::lower_bound(courses.begin(), courses.end(), number, byNumber);
+    }
+
+    void insert(Course&& course) { courses.push_back(std::move(course)); }
+    void finishLoad() {
+        std::sort(courses.begin(), courses.end(),
+                  [](const Course& a, const Course& b) { return a.courseNumber < b.courseNumber; });
+    }
+    const Course* find(const std::string& number) const {
+        auto it = std::lower_bound(courses.begin(), courses.end(), number, byNumber);
+        return it != courses.end() && it->courseNumber == number ? &*it : nullptr;
+    }
+    bool erase(const std::string& number) {
+        auto it = position(number);
+        if (it == courses.end() || it->courseNumber != number)
+            return false;
+        courses.erase(it);
+        return true;
+    }
+    bool upsert(Course&& course) {
+        auto it = position(course.courseNumber);
+        if (it != courses.end() && it->courseNumber == course.courseNumber) {
+            *it = std::move(course);
+            return false;
+        }
+        courses.insert(it, std::move(course));
+        return true;
+    }
+    std::size_t size() const { return courses.size(); }
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const Course& course : courses)
+            visit(course);
+    }
+    const char* checkInvariants() const { return nullptr; }
+    std::size_t height() const { return 0; }
+};
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Records the first invariant violation of the run.
+template <typename Container>
+void checkShape(const Container& container, const char* phase, Measurement& m) {
+    const char* problem = container.checkInvariants();
+    if (problem && m.problem.empty())
+        m.problem = std::string(phase) + ": " + problem;
+}
+
+/*
+* runContainer: Plays the stream's three phases against a fresh container. Courses are copied
+*               out of the stream before each timed loop and moved in, so the loops time the
+*               container and not the copies. Memory is the heap growth once the load's source
+*               vector is gone: the container's nodes, buckets or array plus the courses' strings.
+*/
+template <typename Container>
+Measurement runContainer(const Stream& stream, const Options& options) {
+    Measurement m;
+    long long heapBefore = liveHeapBytes.load(std::memory_order_relaxed);
+    auto container = std::make_unique<Container>();
+    std::vector<Course> loadCourses = stream.loadCourses;
+
+    auto start = Clock::now();
+    for (Course& course : loadCourses)
+        container->insert(std::move(course));
+    container->finishLoad();
+    m.insertNs = elapsedNs(start) / static_cast<double>(loadCourses.size());
+    std::vector<Course>().swap(loadCourses);
+    m.bytesPerEntry = static_cast<double>(liveHeapBytes.load(std::memory_order_relaxed) - heapBefore)
+        / static_cast<double>(container->size());
+    m.height = container->height();
+    checkShape(*container, "after the load", m);
+    if (container->size() != stream.loads.size())
+        ++m.mismatches;
+
+    std::vector<const Course*> found(stream.lookups.size());
+    start = Clock::now();
+    for (std::size_t i = 0; i < stream.lookups.size(); ++i)
+        found[i] = container->find(stream.keys[stream.lookups[i]]);
+    m.lookupNs = stream.lookups.empty() ? 0 : elapsedNs(start) / static_cast<double>(stream.lookups.size());
+    for (std::size_t i = 0; i < found.size(); ++i)
+        m.mismatches += titleCode(found[i]) != stream.expectedLookups[i];
+
+    std::vector<Course> churnCourses = stream.churnCourses;
+    std::vector<std::uint64_t> results(stream.churn.size());
+    std::size_t segment = options.checkEvery ? options.checkEvery : stream.churn.size();
+    double churnNs = 0;
+    for (std::size_t first = 0; first < stream.churn.size(); first += segment) {
+        std::size_t last = std::min(stream.churn.size(), first + segment);
+        start = Clock::now();
+        for (std::size_t i = first; i < last; ++i) {
+            const Op& op = stream.churn[i];
+            const std::string& key = stream.keys[op.key];
+            if (op.kind == OpKind::Find)
+                results[i] = titleCode(container->find(key));
+            else if (op.kind == OpKind::Erase)
+                results[i] = container->erase(key);
+            else
+                results[i] = container->upsert(std::move(churnCourses[i]));
+        }
+        churnNs += elapsedNs(start);
+        checkShape(*container, "during the churn", m);
+    }
+    m.churnNs = stream.churn.empty() ? 0 : churnNs / static_cast<double>(stream.churn.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+        m.mismatches += results[i] != stream.expectedChurn[i];
+
+    // Final contents: in order for the ordered containers, by lookup for the hash map.
+    if (container->size() != stream.finalKeys.size())
+        ++m.mismatches;
+    if constexpr (Container::ordered) {
+        std::size_t i = 0;
+        container->forEach([&](const Course& course) {
+            if (i >= stream.finalKeys.size() || course.courseNumber != stream.keys[stream.finalKeys[i]]
+                || course.courseTitle != stream.finalTitles[i])
+                ++m.mismatches;
+            ++i;
+        });
+    }
+    else {
+        for (std::size_t i = 0; i < stream.finalKeys.size(); ++i) {
+            const Course* course = container->find(stream.keys[stream.finalKeys[i]]);
+            if (!course || course->courseTitle != stream.finalTitles[i])
+                ++m.mismatches;
+        }
+    }
+    checkShape(*container, "at the end", m);
+    return m;
+}
+
+Measurement runContainer(const std::string& name, const Stream& stream, const Options& options) {
+    if (name == "tree")
+        return runContainer<CatalogContainer>(stream, options);
+    if (name == "compact")
+        return runContainer<CompactContainer>(stream, options);
+    if (name == "map")
+        return runContainer<MapContainer<std::map<std::string, Course, std::less<>>, true>>(stream, options);
+    if (name == "unordered")
+        return runContainer<MapContainer<std::unordered_map<std::string, Course>, false>>(stream, options);
+    return runContainer<SortedVectorContainer>(stream, options);
+}
+
+// Median over the rounds of one per-operation time, as millions of operations per second.
+double medianMops(const Result& result, double Measurement::*field) {
+    std::vector<double> samples;
+    for (const Measurement& m : result.rounds)
+        samples.push_back(m.*field);
+    std::sort(samples.begin(), samples.end());
+    double ns = samples[samples.size() / 2];
+    return ns > 0 ? 1e3 / ns : 0.0;
+}
+
+// "ok", or the mismatch count and first invariant violation over all rounds.
+std::string verdict(const Result& result) {
+    std::size_t mismatches = 0;
+    std::string problem;
+    for (const Measurement& m : result.rounds) {
+        mismatches += m.mismatches;
+        if (problem.empty())
+            problem = m.problem;
+    }
+    if (!mismatches && problem.empty())
+        return "ok";
+    std::string text;
+    if (mismatches)
+        text = std::to_string(mismatches) + " mismatches";
+    if (!problem.empty())
+        text += (text.empty() ? "" : "; ") + problem;
+    return text;
+}
+
+bool failed(const Result& result) { return verdict(result) != "ok"; }
+
+// The largest height and memory seen over the rounds.
+std::size_t maxHeight(const Result& result) {
+    std::size_t height = 0;
+    for (const Measurement& m : result.rounds)
+        height = std::max(height, m.height);
+    return height;
+}
+
+double maxBytes(const Result& result) {
+    double bytes = 0;
+    for (const Measurement& m : result.rounds)
+        bytes = std::max(bytes, m.bytesPerEntry);
+    return bytes;
+}
+
+void writeText(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+    // A red-black tree of n nodes is at most 2 log2(n + 1) high.
+    std::size_t bound = static_cast<std::size_t>(2 * std::log2(static_cast<double>(options.size) + 1));
+    out << "size " << options.size << ", lookups " << options.lookups << ", churn " << options.churn
+        << ", rounds " << options.rounds << "; throughput in Mops/s (median), height bound " << bound << "\n";
+    out << std::left << std::setw(10) << "order" << std::setw(9) << "lookups" << std::right << std::setw(5) << "hit%"
+        << "  " << std::left << std::setw(11) << "container" << std::right << std::setw(9) << "insert"
+        << std::setw(9) << "lookup" << std::setw(9) << "churn" << std::setw(13) << "bytes/entry"
+        << std::setw(8) << "height" << "  result\n";
+    out << std::fixed;
+    for (const Result& result : results) {
+        std::size_t height = maxHeight(result);
+        out << std::left << std::setw(10) << result.order << std::setw(9) << result.lookup << std::right
+            << std::setw(5) << result.hitRatio << "  " << std::left << std::setw(11) << result.container << std::right
+            << std::setprecision(2) << std::setw(9) << medianMops(result, &Measurement::insertNs)
+            << std::setw(9) << medianMops(result, &Measurement::lookupNs)
+            << std::setw(9) << medianMops(result, &Measurement::churnNs)
+            << std::setprecision(1) << std::setw(13) << maxBytes(result)
+            << std::setw(8) << (height ? std::to_string(height) : "-") << "  " << verdict(result) << "\n";
+    }
+}
+
+void writeCsv(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+    out << "order,lookups,hit_ratio,container,size,rounds,insert_mops,lookup_mops,churn_mops,bytes_per_entry,height,result\n";
+    out << std::setprecision(10);
+    for (const Result& result : results) {
+        out << result.order << "," << result.lookup << "," << result.hitRatio << "," << result.container << ","
+            << options.size << "," << result.rounds.size() << "," << medianMops(result, &Measurement::insertNs) << ","
+            << medianMops(result, &Measurement::lookupNs) << "," << medianMops(result, &Measurement::churnNs) << ","
+            << maxBytes(result) << "," << maxHeight(result) << ",\"" << verdict(result) << "\"\n";
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    std::vector<Result> results;
+    try {
+        for (const auto& order : options.orders) {
+            for (const auto& lookup : options.lookupDistributions) {
+                for (unsigned hitRatio : options.hitRatios) {
+                    std::size_t first = results.size();
+                    for (const auto& container : options.containers)
+                        results.push_back({ order, lookup, hitRatio, container, {} });
+                    for (unsigned round = 0; round < options.rounds; ++round) {
+                        std::cerr << order << " / " << lookup << " / " << hitRatio << "% hits, round "
+                            << round + 1 << "\n";
+                        Stream stream = makeStream(options, order, lookup, hitRatio, options.seed + round);
+                        for (std::size_t c = 0; c < options.containers.size(); ++c)
+                            results[first + c].rounds.push_back(runContainer(options.containers[c], stream, options));
+                    }
+                }
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Error: Could not open " << options.output << " for writing\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    if (options.format == "csv")
+        writeCsv(out, results, options);
+    else
+        writeText(out, results, options);
+    return std::any_of(results.begin(), results.end(), failed) ? 1 : 0;
+}
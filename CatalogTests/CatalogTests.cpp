@@ -0,0 +1,263 @@
+/*
+    File: CatalogTests.cpp
+    Author: Braydon Woodward
+    Created: October 17th, 2026
+    Description: Checks for RedBlackTree's erase and reload paths and its observers, and for
+                 SnapshotTree with more live snapshots than one block of reader slots, run by
+                 CTest. Fixed cases cover a missing key, duplicate numbers, the reload summary,
+                 reload from a file and two observers on one tree; a seeded random walk then
+                 compares every erase, upsert and reload against std::map. Prints each failure
+                 and exits with status 1 if any.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../CSCourseTree/ClosureCache.h"
+#include "../CSCourseTree/Course.h"
+#include "../CSCourseTree/SnapshotTree.h"
+#include "../CSCourseTree/TitleIndex.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+// The tree's courses in order, as number -> title.
+std::map<std::string, std::string> contents(const RedBlackTree& tree) {
+    std::map<std::string, std::string> courses;
+    tree.forEachInOrder([&](const Course& course) { courses.emplace(course.courseNumber, course.courseTitle); });
+    return courses;
+}
+
+void checkShape(const RedBlackTree& tree, const std::string& when) {
+    const char* problem = tree.checkInvariants();
+    check(problem == nullptr, when + ": " + (problem ? problem : ""));
+}
+
+bool sameSummary(const ReloadSummary& a, const ReloadSummary& b) {
+    return a.added == b.added && a.changed == b.changed && a.removed == b.removed && a.unchanged == b.unchanged;
+}
+
+/*
+* eraseCases: Missing keys leave the tree alone; present ones go, one node per call.
+*/
+void eraseCases() {
+    RedBlackTree tree;
+    check(!tree.erase("CSCI100"), "erase from an empty tree returns false");
+
+    tree.insert(Course("CSCI100", "Intro"));
+    tree.insert(Course("CSCI200", "Data Structures"));
+    tree.insert(Course("CSCI300", "Algorithms"));
+    check(!tree.erase("CSCI250"), "erase of a missing key returns false");
+    check(!tree.erase("CSCI1000"), "erase of a key that only shares a prefix returns false");
+    check(!tree.erase(""), "erase of the empty key returns false");
+    check(tree.size() == 3, "a missing-key erase leaves the size alone");
+
+    check(tree.erase("CSCI200"), "erase of a present key returns true");
+    check(tree.size() == 2 && tree.find("CSCI200") == nullptr, "an erased course is gone");
+    check(!tree.erase("CSCI200"), "a second erase of the same key returns false");
+    checkShape(tree, "after erase");
+
+    tree.insert(Course("CSCI100", "Intro, second copy"));
+    check(tree.erase("CSCI100") && tree.erase("CSCI100"), "each erase removes one of two duplicates");
+    check(!tree.erase("CSCI100") && tree.size() == 1, "no duplicate is left behind");
+    checkShape(tree, "after erasing duplicates");
+}
+
+/*
+* reloadCases: The summary counts each kind of difference, and the tree ends up holding
+*              exactly the new records.
+*/
+void reloadCases() {
+    RedBlackTree tree;
+    ReloadSummary summary = tree.reload({ Course("A100", "One"), Course("A200", "Two"), Course("A300", "Three") });
+    check(sameSummary(summary, { 3, 0, 0, 0 }), "a reload into an empty tree adds every record");
+
+    Course changed("A200", "Two");
+    changed.prerequisites.push_back("A100");
+    summary = tree.reload({ Course("A100", "One"), changed, Course("A400", "Four"), Course("A400", "Four, revised") });
+    check(sameSummary(summary, { 1, 1, 1, 1 }), "reload counts added, changed, removed and unchanged");
+    std::map<std::string, std::string> expected{ { "A100", "One" }, { "A200", "Two" }, { "A400", "Four, revised" } };
+    check(contents(tree) == expected, "reload leaves exactly the new records, the last one per number");
+    check(tree.find("A200") && tree.find("A200")->prerequisites.size() == 1, "a changed prerequisite list is stored");
+
+    tree.insert(Course("A100", "One, duplicate"));
+    summary = tree.reload({ Course("A100", "One"), changed, Course("A400", "Four, revised") });
+    check(sameSummary(summary, { 0, 0, 1, 3 }), "reload collapses duplicate numbers into one node");
+    check(tree.size() == 3, "one node per number after the reload");
+
+    summary = tree.reload(std::vector<Course>());
+    check(sameSummary(summary, { 0, 0, 3, 0 }) && tree.size() == 0, "reloading nothing removes everything");
+    checkShape(tree, "after reload cases");
+
+    const char* fileName = "CatalogTests_reload.csv";
+    {
+        std::ofstream file(fileName);
+        file << "B100,First\nB200,Second,B100\n";
+    }
+    summary = tree.reload(std::string(fileName));
+    check(sameSummary(summary, { 2, 0, 0, 0 }), "reload from a file adds its records");
+    {
+        std::ofstream file(fileName);
+        file << "B200,Second,B100\nB300,Third\n";
+    }
+    summary = tree.reload(std::string(fileName));
+    check(sameSummary(summary, { 1, 0, 1, 1 }), "reload from a changed file counts the difference");
+    std::remove(fileName);
+}
+
+/*
+* observerCases: A title index and a closure cache attached to the same tree both follow
+*                every change, and a detached one stops hearing about them.
+*/
+void observerCases() {
+    RedBlackTree tree;
+    TitleIndex titles;
+    ClosureCache closures;
+    tree.insert(Course("M100", "Calculus"));
+    tree.addObserver(&titles);
+    tree.addObserver(&closures);
+    tree.addObserver(&titles);
+    check(titles.size() == 1, "an observer attached after loading is caught up, once");
+
+    Course advanced("M200", "Advanced Calculus");
+    advanced.prerequisites.push_back("M100");
+    tree.insert(advanced);
+    check(titles.search("calculus").size() == 2, "the title index sees an insert");
+    check(closures.closureSize("M200") == 1, "the closure cache sees the same insert");
+
+    Course renamed("M100", "Linear Algebra");
+    renamed.prerequisites.push_back("M050");
+    tree.upsert(renamed);
+    tree.insert(Course("M050", "Precalculus"));
+    check(titles.search("algebra").size() == 1 && titles.search("calculus").size() == 1,
+          "the title index sees a replacement");
+    check(closures.closureSize("M200") == 2, "the closure cache sees the replacement and its new prerequisite");
+
+    tree.removeObserver(&titles);
+    tree.erase("M050");
+    check(titles.size() == 3, "a detached observer hears nothing more");
+    check(closures.closureSize("M200") == 1, "the still-attached observer sees the erase");
+
+    tree.reload({ Course("M300", "Topology") });
+    check(closures.closureSize("M200") == 0 && closures.closureSize("M300") == 0,
+          "the still-attached observer follows a reload");
+}
+
+/*
+* snapshotCases: Hundreds of live snapshots each keep their own version, and one pinned in a
+*                chained slot block still holds back reclamation after the rest are gone.
+*/
+void snapshotCases() {
+    RedBlackTree source;
+    source.insert(Course("S100", "Original"));
+    SnapshotTree tree;
+    tree.assign(source);
+
+    std::optional<SnapshotTree::Snapshot> late;
+    {
+        std::vector<SnapshotTree::Snapshot> early;
+        for (int i = 0; i < 300; ++i) {
+            early.push_back(tree.snapshot());
+            tree.upsert(Course("S" + std::to_string(200 + i), "Added"));
+        }
+        bool pinned = true;
+        for (std::size_t i = 0; i < early.size(); ++i)
+            pinned = pinned && early[i].size() == i + 1 && !early[i].search("S" + std::to_string(200 + i));
+        check(pinned, "300 live snapshots each see the version they pinned");
+        late.emplace(tree.snapshot());
+    }
+    tree.upsert(Course("S100", "Replaced"));
+    check(tree.pendingReclaim() > 0, "a snapshot in a chained slot block holds back reclamation");
+    check(late->search("S100") && late->search("S100")->courseTitle == "Original",
+          "a snapshot in a chained slot block keeps its version");
+
+    late.reset();
+    tree.upsert(Course("S100", "Replaced again"));
+    check(tree.pendingReclaim() == 0, "everything is reclaimed once the last snapshot is gone");
+    check(tree.snapshot().size() == 301, "a fresh snapshot sees every write");
+}
+
+/*
+* randomWalk: Erases, upserts and reloads over a small key space so hits, misses and
+*             replacements all happen often; the model and the expected summary come from
+*             std::map.
+*/
+void randomWalk() {
+    std::mt19937 rng(7);
+    auto randomKey = [&]() { return "K" + std::to_string(rng() % 200); };
+    auto randomTitle = [&]() { return "T" + std::to_string(rng() % 3); };
+    RedBlackTree tree;
+    std::map<std::string, std::string> model;
+
+    for (int step = 0; step < 4000; ++step) {
+        unsigned roll = rng() % 100;
+        if (roll < 40) {
+            std::string key = randomKey();
+            bool erased = tree.erase(key);
+            check(erased == (model.erase(key) == 1), "erase result matches std::map for " + key);
+        }
+        else if (roll < 98) {
+            Course course(randomKey(), randomTitle());
+            bool inserted = tree.upsert(course);
+            check(inserted == (model.count(course.courseNumber) == 0), "upsert result matches std::map");
+            model[course.courseNumber] = course.courseTitle;
+        }
+        else {
+            std::vector<Course> records;
+            std::map<std::string, std::string> next;
+            for (int i = rng() % 150; i > 0; --i) {
+                records.emplace_back(randomKey(), randomTitle());
+                next[records.back().courseNumber] = records.back().courseTitle;
+            }
+            ReloadSummary expected;
+            for (const auto& [key, title] : next) {
+                auto old = model.find(key);
+                if (old == model.end())
+                    ++expected.added;
+                else if (old->second != title)
+                    ++expected.changed;
+                else
+                    ++expected.unchanged;
+            }
+            expected.removed = model.size() - expected.changed - expected.unchanged;
+            ReloadSummary summary = tree.reload(std::move(records));
+            check(sameSummary(summary, expected), "reload summary matches std::map at step " + std::to_string(step));
+            model.swap(next);
+        }
+        if (step % 100 == 0) {
+            check(contents(tree) == model, "contents match std::map at step " + std::to_string(step));
+            checkShape(tree, "step " + std::to_string(step));
+        }
+    }
+    check(contents(tree) == model, "contents match std::map at the end");
+    checkShape(tree, "end of the random walk");
+}
+
+}
+
+int main() {
+    eraseCases();
+    reloadCases();
+    observerCases();
+    snapshotCases();
+    randomWalk();
+    if (failures) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All checks passed\n";
+    return 0;
+}
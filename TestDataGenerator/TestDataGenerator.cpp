@@ -1,43 +1,492 @@
 /*
     File: GenerateTestData.cpp
     Author: Braydon Woodward (Updated)
-    Created: March 28th, 2025
-    Description: This program generates a test data file (ABCUCourses.txt).
+    Created: March 28th, 2025 [Updated October 17th, 2026]
+    Description: This program generates a test data file (ABCUCourses.txt by default).
                  Each record is formatted in CSV style with a course code, course title, and prerequisites.
+                 With no options it writes the original 2000 sorted TEST1000..TEST2999 records; the
+                 options below scale it to tens of millions of records with realistic or adversarial
+                 key orders, department mixes, titles and prerequisite graphs. Records are computed
+                 one at a time from (seed, rank) and streamed through a large write buffer, so memory
+                 use does not grow with the record count.
 */
 
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+namespace {
+
+// Small, fast, seedable generator; one is derived per record so any record can be recomputed.
+struct SplitMix64 {
+    std::uint64_t state;
+
+    explicit SplitMix64(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound).
+    std::uint64_t below(std::uint64_t bound) { return bound ? next() % bound : 0; }
+
+    // Uniform in [0, 1).
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+std::uint64_t mix(std::uint64_t seed, std::uint64_t stream, std::uint64_t value) {
+    return SplitMix64(seed ^ (stream * 0xD1B54A32D192ED03ull) ^ (value * 0x9E3779B97F4A7C15ull)).next();
+}
+
+enum class KeyOrder { Sorted, Reversed, Random, NearlySorted };
+enum class FanIn { Legacy, Fixed, Uniform, Geometric };
 
-int main() {
-    // Open the file ABCUCourses.txt for writing (will overwrite if exists)
-    std::ofstream outFile("../CSCourseTree/ABCUCourses.txt");
+struct Department {
+    std::string code;
+    double weight = 1.0;
+    std::uint64_t count = 0;        // records assigned to this department
+    std::uint64_t firstRank = 0;    // sorted rank of its first record
+    int width = 4;                  // digits in its course numbers
+};
+
+struct Options {
+    std::uint64_t count = 2000;
+    std::string output = "../CSCourseTree/ABCUCourses.txt";
+    KeyOrder order = KeyOrder::Sorted;
+    double disorder = 0.05;         // nearly-sorted: fraction of records moved
+    std::vector<Department> departments{ Department{ "TEST" } };
+    int titleMin = 0;               // 0 = "Course Title for <code>"
+    int titleMax = 0;
+    FanIn fanIn = FanIn::Legacy;
+    double fanInA = 0;              // fixed K, uniform min, geometric mean
+    double fanInB = 0;              // uniform max
+    std::uint64_t depth = 0;        // > 0: prerequisite chains are at most this many courses long
+    std::uint64_t window = 16;      // depth 0: prerequisites come from this many preceding courses
+    double cycleRate = 0.0;
+    std::uint64_t seed = 1;
+};
+
+/*
+* usage: Prints the command-line options.
+*/
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+        << "  --count N                 number of records (default 2000)\n"
+        << "  --output FILE             output path (default ../CSCourseTree/ABCUCourses.txt)\n"
+        << "  --order ORDER             sorted | reversed | random | nearly-sorted (default sorted)\n"
+        << "  --disorder F              nearly-sorted: fraction of records displaced locally (default 0.05)\n"
+        << "  --departments LIST        department codes with optional weights, e.g. CSCI:4,MATH:2,PHYS\n"
+        << "                            (default TEST)\n"
+        << "  --title-length MIN-MAX    generated title length in characters\n"
+        << "                            (default \"Course Title for <code>\")\n"
+        << "  --fan-in DIST             prerequisites per course: legacy | fixed:K | uniform:MIN-MAX |\n"
+        << "                            geometric:MEAN (default legacy, the original i % 4 pattern)\n"
+        << "  --depth L                 limit prerequisite chains to L courses by drawing prerequisites\n"
+        << "                            from the previous of L bands (default 0 = no limit)\n"
+        << "  --window W                with no depth limit, draw prerequisites from the W preceding\n"
+        << "                            courses (default 16)\n"
+        << "  --cycle-rate F            fraction of courses paired into a two-course prerequisite cycle\n"
+        << "  --seed N                  random seed (default 1)\n";
+}
+
+std::pair<double, double> parseRange(const std::string& text) {
+    std::size_t dash = text.find('-');
+    if (dash == std::string::npos)
+        return { std::stod(text), std::stod(text) };
+    return { std::stod(text.substr(0, dash)), std::stod(text.substr(dash + 1)) };
+}
+
+/*
+* parseOptions: Reads --name value pairs. Throws std::invalid_argument on any bad input.
+*/
+void parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string name = argv[i];
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + name);
+        std::string value = argv[++i];
+        if (name == "--count")
+            options.count = std::stoull(value);
+        else if (name == "--output")
+            options.output = value;
+        else if (name == "--order") {
+            if (value == "sorted") options.order = KeyOrder::Sorted;
+            else if (value == "reversed") options.order = KeyOrder::Reversed;
+            else if (value == "random") options.order = KeyOrder::Random;
+            else if (value == "nearly-sorted") options.order = KeyOrder::NearlySorted;
+            else throw std::invalid_argument("unknown order " + value);
+        }
+        else if (name == "--disorder")
+            options.disorder = std::min(1.0, std::max(0.0, std::stod(value)));
+        else if (name == "--departments") {
+            options.departments.clear();
+            std::stringstream ss(value);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                Department department;
+                std::size_t colon = item.find(':');
+                department.code = item.substr(0, colon);
+                if (colon != std::string::npos)
+                    department.weight = std::stod(item.substr(colon + 1));
+                bool letters = !department.code.empty() && std::all_of(department.code.begin(), department.code.end(),
+                    [](char c) { return c >= 'A' && c <= 'Z'; });
+                if (!letters || department.weight <= 0)
+                    throw std::invalid_argument("department codes must be upper-case letters with positive weights: " + item);
+                for (const auto& existing : options.departments)
+                    if (existing.code == department.code)
+                        throw std::invalid_argument("duplicate department " + department.code);
+                options.departments.push_back(department);
+            }
+            if (options.departments.empty())
+                throw std::invalid_argument("--departments needs at least one code");
+        }
+        else if (name == "--title-length") {
+            auto range = parseRange(value);
+            options.titleMin = static_cast<int>(range.first);
+            options.titleMax = static_cast<int>(range.second);
+            if (options.titleMin < 1 || options.titleMax < options.titleMin)
+                throw std::invalid_argument("--title-length needs 1 <= MIN <= MAX");
+        }
+        else if (name == "--fan-in") {
+            std::size_t colon = value.find(':');
+            std::string kind = value.substr(0, colon);
+            std::string argument = colon == std::string::npos ? "" : value.substr(colon + 1);
+            if (kind == "legacy")
+                options.fanIn = FanIn::Legacy;
+            else if (kind == "fixed") {
+                options.fanIn = FanIn::Fixed;
+                options.fanInA = std::stod(argument);
+            }
+            else if (kind == "uniform") {
+                options.fanIn = FanIn::Uniform;
+                auto range = parseRange(argument);
+                options.fanInA = range.first;
+                options.fanInB = range.second;
+                if (options.fanInB < options.fanInA)
+                    throw std::invalid_argument("--fan-in uniform needs MIN <= MAX");
+            }
+            else if (kind == "geometric") {
+                options.fanIn = FanIn::Geometric;
+                options.fanInA = std::stod(argument);
+            }
+            else
+                throw std::invalid_argument("unknown fan-in distribution " + value);
+            if (options.fanInA < 0)
+                throw std::invalid_argument("--fan-in values must not be negative");
+        }
+        else if (name == "--depth")
+            options.depth = std::stoull(value);
+        else if (name == "--window")
+            options.window = std::max<std::uint64_t>(1, std::stoull(value));
+        else if (name == "--cycle-rate")
+            options.cycleRate = std::min(1.0, std::max(0.0, std::stod(value)));
+        else if (name == "--seed")
+            options.seed = std::stoull(value);
+        else
+            throw std::invalid_argument("unknown option " + name);
+    }
+}
+
+/*
+* assignDepartments: Splits the record count across departments by weight (largest remainder),
+*                    and lays them out alphabetically so sorted rank maps straight to a code.
+*/
+void assignDepartments(Options& options) {
+    auto& departments = options.departments;
+    std::sort(departments.begin(), departments.end(),
+        [](const Department& a, const Department& b) { return a.code < b.code; });
+    double totalWeight = 0;
+    for (const auto& d : departments)
+        totalWeight += d.weight;
+    std::uint64_t assigned = 0;
+    std::vector<std::pair<double, std::size_t>> remainders;
+    for (std::size_t i = 0; i < departments.size(); ++i) {
+        double exact = static_cast<double>(options.count) * departments[i].weight / totalWeight;
+        departments[i].count = static_cast<std::uint64_t>(exact);
+        assigned += departments[i].count;
+        remainders.push_back({ exact - static_cast<double>(departments[i].count), i });
+    }
+    std::sort(remainders.rbegin(), remainders.rend());
+    for (std::size_t i = 0; assigned < options.count; ++i, ++assigned)
+        ++departments[remainders[i % remainders.size()].second].count;
+
+    std::uint64_t rank = 0;
+    for (auto& d : departments) {
+        d.firstRank = rank;
+        rank += d.count;
+        // Course numbers start at 1000 and are zero padded so numeric and text order agree.
+        d.width = static_cast<int>(std::to_string(1000 + (d.count ? d.count - 1 : 0)).size());
+    }
+}
+
+/*
+* appendCode: Appends the course code with the given sorted rank. Because departments are
+*             alphabetical and numbers are fixed width, rank order is the tree's key order.
+*/
+void appendCode(std::string& out, const Options& options, std::uint64_t rank) {
+    const auto& departments = options.departments;
+    auto it = std::upper_bound(departments.begin(), departments.end(), rank,
+        [](std::uint64_t r, const Department& d) { return r < d.firstRank; });
+    const Department& d = *(it - 1);
+    out += d.code;
+    std::size_t end = out.size() + static_cast<std::size_t>(d.width);
+    out.resize(end, '0');
+    for (std::uint64_t number = 1000 + rank - d.firstRank; number; number /= 10)
+        out[--end] = static_cast<char>('0' + number % 10);
+}
+
+/*
+* Class: RandomPermutation
+* Description: A seeded bijection on [0, n) built from a four-round Feistel network with cycle
+*              walking, so random key order needs no table of n entries.
+*/
+class RandomPermutation {
+private:
+    std::uint64_t n;
+    std::uint64_t seed;
+    int halfBits;
+    std::uint64_t halfMask;
+
+    std::uint64_t encrypt(std::uint64_t x) const {
+        std::uint64_t left = x >> halfBits;
+        std::uint64_t right = x & halfMask;
+        for (std::uint64_t round = 0; round < 4; ++round) {
+            std::uint64_t next = left ^ (mix(seed, round, right) & halfMask);
+            left = right;
+            right = next;
+        }
+        return (left << halfBits) | right;
+    }
+
+public:
+    RandomPermutation(std::uint64_t size, std::uint64_t seedValue) : n(size), seed(seedValue), halfBits(1) {
+        while ((std::uint64_t(1) << (2 * halfBits)) < n)
+            ++halfBits;
+        halfMask = (std::uint64_t(1) << halfBits) - 1;
+    }
+
+    std::uint64_t operator()(std::uint64_t i) const {
+        std::uint64_t x = encrypt(i);
+        while (x >= n)
+            x = encrypt(x);
+        return x;
+    }
+};
+
+/*
+* Class: NearlySortedOrder
+* Description: Sorted order with a fraction of records displaced inside fixed blocks, produced
+*              one block at a time.
+*/
+class NearlySortedOrder {
+private:
+    static constexpr std::uint64_t blockSize = 1024;
+    std::uint64_t n;
+    std::uint64_t seed;
+    double disorder;
+    std::uint64_t blockStart = ~std::uint64_t(0);
+    std::vector<std::uint64_t> block;
+
+public:
+    NearlySortedOrder(std::uint64_t size, std::uint64_t seedValue, double fraction)
+        : n(size), seed(seedValue), disorder(fraction) {}
+
+    std::uint64_t operator()(std::uint64_t i) {
+        std::uint64_t start = i - i % blockSize;
+        if (start != blockStart) {
+            blockStart = start;
+            std::uint64_t length = std::min(blockSize, n - start);
+            block.resize(length);
+            for (std::uint64_t j = 0; j < length; ++j)
+                block[j] = start + j;
+            SplitMix64 rng(mix(seed, 7, start));
+            // Each swap moves two records, so half as many swaps as displaced records.
+            std::uint64_t swaps = static_cast<std::uint64_t>(disorder * static_cast<double>(length) / 2.0 + 0.5);
+            for (std::uint64_t s = 0; s < swaps; ++s)
+                std::swap(block[rng.below(length)], block[rng.below(length)]);
+        }
+        return block[i - blockStart];
+    }
+};
+
+/*
+* prerequisiteRanks: The acyclic prerequisites of the course at this sorted rank. Every course
+*                    points only at lower ranks, so the graph is a DAG before cycles are added.
+*/
+void prerequisiteRanks(const Options& options, std::uint64_t rank, std::vector<std::uint64_t>& out) {
+    out.clear();
+    if (options.fanIn == FanIn::Legacy) {
+        std::uint64_t mod = rank % 4;
+        if ((mod == 1 || mod == 2) && rank >= 1)
+            out.push_back(rank - 1);
+        else if (mod == 3 && rank >= 3) {
+            out.push_back(rank - 1);
+            out.push_back(rank - 3);
+        }
+        return;
+    }
+
+    // Candidate ranks: the previous band when depth is limited, else a window of predecessors.
+    std::uint64_t low, high;
+    if (options.depth > 0) {
+        std::uint64_t band = rank * options.depth / options.count;
+        if (band == 0)
+            return;
+        low = (band - 1) * options.count / options.depth;
+        while (low * options.depth / options.count < band - 1)
+            ++low;
+        high = band * options.count / options.depth;
+        while (high * options.depth / options.count < band)
+            ++high;
+    }
+    else {
+        low = rank > options.window ? rank - options.window : 0;
+        high = rank;
+    }
+    std::uint64_t candidates = high - low;
+
+    SplitMix64 rng(mix(options.seed, 1, rank));
+    std::uint64_t k = 0;
+    if (options.fanIn == FanIn::Fixed)
+        k = static_cast<std::uint64_t>(options.fanInA);
+    else if (options.fanIn == FanIn::Uniform)
+        k = static_cast<std::uint64_t>(options.fanInA) + rng.below(static_cast<std::uint64_t>(options.fanInB - options.fanInA) + 1);
+    else {
+        double p = options.fanInA / (1.0 + options.fanInA);
+        while (k < candidates && rng.unit() < p)
+            ++k;
+    }
+    k = std::min(k, candidates);
+
+    // Distinct picks; fan-in is small next to the candidate range except in tiny catalogs.
+    while (out.size() < k) {
+        std::uint64_t pick = low + rng.below(candidates);
+        if (std::find(out.begin(), out.end(), pick) == out.end())
+            out.push_back(pick);
+    }
+}
+
+// Whether the course at this rank is paired with rank + 1 into a two-course cycle.
+bool startsCycle(const Options& options, std::uint64_t rank) {
+    if (options.cycleRate <= 0 || rank + 1 >= options.count)
+        return false;
+    return SplitMix64(mix(options.seed, 2, rank)).unit() < options.cycleRate / 2.0;
+}
+
+/*
+* appendTitle: Appends the course title; generated titles are words from a fixed vocabulary
+*              cut to a length drawn from [titleMin, titleMax].
+*/
+void appendTitle(std::string& out, const Options& options, std::uint64_t rank, const std::string& code) {
+    if (options.titleMin == 0) {
+        out += "Course Title for ";
+        out += code;
+        return;
+    }
+    static const char* const words[] = {
+        "Introduction", "to", "Advanced", "Topics", "in", "Data", "Structures", "Algorithms",
+        "Systems", "Theory", "Applied", "Computational", "Methods", "Analysis", "Design",
+        "Networks", "Security", "Databases", "Programming", "Languages", "and", "Modern",
+        "Foundations", "of", "Machine", "Learning", "Software", "Engineering", "Seminar", "Lab"
+    };
+    SplitMix64 rng(mix(options.seed, 3, rank));
+    std::size_t length = static_cast<std::size_t>(options.titleMin)
+        + static_cast<std::size_t>(rng.below(static_cast<std::uint64_t>(options.titleMax - options.titleMin) + 1));
+    std::size_t start = out.size();
+    while (out.size() - start < length) {
+        if (out.size() > start)
+            out += ' ';
+        out += words[rng.below(sizeof(words) / sizeof(words[0]))];
+    }
+    out.resize(start + length);
+    if (out.back() == ' ')
+        out.back() = 'X';
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        parseOptions(argc, argv, options);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        usage(argv[0]);
+        return 1;
+    }
+    options.depth = std::min(options.depth, options.count);
+    assignDepartments(options);
+
+    // Open the output file for writing (will overwrite if exists)
+    std::ofstream outFile(options.output, std::ios::binary);
     if (!outFile) {
-        std::cerr << "Error: Could not open ABCUCourses.txt for writing." << std::endl;
+        std::cerr << "Error: Could not open " << options.output << " for writing." << std::endl;
         return 1;
     }
 
-    // Generate 775 test records, from TEST1000 to TEST2999
-    for (int i = 1000; i < 3000; ++i) {
-        std::string code = "TEST" + std::to_string(i);
-        std::string record = code + ",Course Title for " + code;
+    RandomPermutation permutation(options.count, options.seed);
+    NearlySortedOrder nearlySorted(options.count, options.seed, options.disorder);
+    std::vector<std::uint64_t> prerequisites;
+    std::string buffer;
+    const std::size_t flushAt = 1 << 20;
+    buffer.reserve(flushAt + 4096);
+    std::string code;
+    std::uint64_t cycles = 0;
+
+    for (std::uint64_t i = 0; i < options.count; ++i) {
+        std::uint64_t rank = i;
+        if (options.order == KeyOrder::Reversed)
+            rank = options.count - 1 - i;
+        else if (options.order == KeyOrder::Random)
+            rank = permutation(i);
+        else if (options.order == KeyOrder::NearlySorted)
+            rank = nearlySorted(i);
 
-        int mod = i % 4;
-        if (mod == 1 || mod == 2) {
-            record += ",TEST" + std::to_string(i - 1);
+        code.clear();
+        appendCode(code, options, rank);
+        buffer += code;
+        buffer += ',';
+        appendTitle(buffer, options, rank, code);
+
+        prerequisiteRanks(options, rank, prerequisites);
+        // A cycle pair (r, r + 1): r also requires r + 1, and r + 1 also requires r.
+        if (startsCycle(options, rank)) {
+            prerequisites.push_back(rank + 1);
+            ++cycles;
         }
-        else if (mod == 3) {
-            record += ",TEST" + std::to_string(i - 1);
-            record += ",TEST" + std::to_string(i - 3);
+        if (rank > 0 && startsCycle(options, rank - 1)
+            && std::find(prerequisites.begin(), prerequisites.end(), rank - 1) == prerequisites.end())
+            prerequisites.push_back(rank - 1);
+        for (std::uint64_t prereq : prerequisites) {
+            buffer += ',';
+            appendCode(buffer, options, prereq);
         }
-        
+        buffer += '\n';
 
-        outFile << record << "\n";
+        if (buffer.size() >= flushAt) {
+            outFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
     }
-
+    outFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
     outFile.close();
-    std::cout << "ABCUCourses.txt has been generated successfully with 2000 records." << std::endl;
+    if (!outFile) {
+        std::cerr << "Error: Could not write " << options.output << "." << std::endl;
+        return 1;
+    }
+
+    std::cout << options.output << " has been generated successfully with " << options.count << " records";
+    if (cycles)
+        std::cout << " (" << cycles << " injected prerequisite cycles)";
+    std::cout << "." << std::endl;
     return 0;
 }
-